@@ -9,7 +9,7 @@ bool Bme280Sensor::begin() {
   Wire.begin();
 
   if (!_bme.begin(_address, &Wire)) {
-    _logger->warn("BME280 sensor not found at address 0x%02X", _address);
+    LOG_WARN(_logger, "BME280 sensor not found at address 0x%02X", _address);
     _available = false;
     return false;
   }
@@ -22,7 +22,7 @@ bool Bme280Sensor::begin() {
                    Adafruit_BME280::FILTER_X16, Adafruit_BME280::STANDBY_MS_500);
 
   _available = true;
-  _logger->info("BME280 sensor initialized at address 0x%02X", _address);
+  LOG_INFO(_logger, "BME280 sensor initialized at address 0x%02X", _address);
   return true;
 }
 
@@ -33,7 +33,7 @@ float Bme280Sensor::readTemperature() {
 
   float temp = _bme.readTemperature();
   if (isnan(temp)) {
-    _logger->warn("BME280: Invalid temperature reading");
+    LOG_WARN(_logger, "BME280: Invalid temperature reading");
     return _lastTemperature;
   }
 
@@ -48,7 +48,7 @@ float Bme280Sensor::readHumidity() {
 
   float humidity = _bme.readHumidity();
   if (isnan(humidity)) {
-    _logger->warn("BME280: Invalid humidity reading");
+    LOG_WARN(_logger, "BME280: Invalid humidity reading");
     return _lastHumidity;
   }
 
@@ -63,7 +63,7 @@ float Bme280Sensor::readPressure() {
 
   float pressure = _bme.readPressure() / 100.0f; // Convert Pa to hPa
   if (isnan(pressure)) {
-    _logger->warn("BME280: Invalid pressure reading");
+    LOG_WARN(_logger, "BME280: Invalid pressure reading");
     return _lastPressure;
   }
 
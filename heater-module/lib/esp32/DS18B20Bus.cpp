@@ -0,0 +1,98 @@
+#include "DS18B20Bus.h"
+#include <cstring>
+
+DS18B20Bus::DS18B20Bus(uint8_t pin, Logger *logger)
+    : TemperatureBus(CONVERSION_MS, DEFAULT_TEMP), _oneWire(pin), _sensors(&_oneWire), _addresses{}, _logger(logger) {}
+
+TemperatureSensor *DS18B20Bus::addProbe(const DeviceAddress address) {
+  const int index = probeCount();
+  TemperatureSensor *probe = TemperatureBus::addProbe();
+  if (probe == nullptr) {
+    LOG_WARN(_logger, "DS18B20 bus full, probe ignored");
+    return nullptr;
+  }
+
+  std::memcpy(_addresses[index], address, sizeof(DeviceAddress));
+  return probe;
+}
+
+void DS18B20Bus::begin() {
+  _sensors.begin();
+  _sensors.setResolution(RESOLUTION);
+  // requestTemperatures() returns right away, poll() collects the results later
+  _sensors.setWaitForConversion(false);
+
+  assignUnclaimedProbes();
+
+  for (int i = 0; i < probeCount(); i++) {
+    const uint8_t *a = _addresses[i];
+    if (!_sensors.isConnected(a)) {
+      LOG_WARN(_logger, "DS18B20 probe %d not found on the bus", i);
+      continue;
+    }
+    LOG_INFO(_logger, "DS18B20 probe %d: %02X%02X%02X%02X%02X%02X%02X%02X", i, a[0], a[1], a[2], a[3], a[4], a[5],
+             a[6], a[7]);
+  }
+  LOG_INFO(_logger, "DS18B20 bus initialized (%d devices)", _sensors.getDeviceCount());
+}
+
+void DS18B20Bus::assignUnclaimedProbes() {
+  DeviceAddress found;
+  uint8_t searchIndex = 0;
+
+  for (int i = 0; i < probeCount(); i++) {
+    if (isAssigned(_addresses[i])) {
+      continue;
+    }
+
+    while (searchIndex < _sensors.getDeviceCount()) {
+      if (_sensors.getAddress(found, searchIndex++) && !isClaimed(found)) {
+        std::memcpy(_addresses[i], found, sizeof(DeviceAddress));
+        break;
+      }
+    }
+  }
+}
+
+bool DS18B20Bus::isAssigned(const uint8_t *address) {
+  for (size_t i = 0; i < sizeof(DeviceAddress); i++) {
+    if (address[i] != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DS18B20Bus::isClaimed(const uint8_t *address) {
+  for (int i = 0; i < probeCount(); i++) {
+    if (std::memcmp(_addresses[i], address, sizeof(DeviceAddress)) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Skip ROM + Convert T: every probe on the bus converts at once
+void DS18B20Bus::startConversion() { _sensors.requestTemperatures(); }
+
+bool DS18B20Bus::collectConversion(int probe, float &celsius) {
+  float temp = _sensors.getTempC(_addresses[probe]);
+
+  if (!isValidReading(temp)) {
+    LOG_WARN(_logger, "DS18B20 probe %d invalid reading (%.2f), keeping last valid", probe, temp);
+    return false;
+  }
+
+  LOG_DEBUG(_logger, "DS18B20 probe %d read: %.2f C", probe, temp);
+  celsius = temp;
+  return true;
+}
+
+bool DS18B20Bus::isValidReading(float temp) {
+  // DS18B20 returns -127 when disconnected and 85 on power-on reset
+  if (temp == DISCONNECTED_TEMP || temp == POWER_ON_RESET_TEMP) {
+    return false;
+  }
+  // Reasonable temperature range check (-55 to +125 is DS18B20 range)
+  return temp >= -55.0f && temp <= 125.0f;
+}
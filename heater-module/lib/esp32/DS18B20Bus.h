@@ -0,0 +1,41 @@
+#pragma once
+#include "Logger.h"
+#include "TemperatureBus.h"
+#include <DallasTemperature.h>
+#include <OneWire.h>
+
+// Every DS18B20 probe wired on a single 1-Wire pin, addressed by ROM code.
+// One broadcast Convert T serves all the probes, then each scratchpad is read once.
+class DS18B20Bus : public TemperatureBus {
+public:
+  DS18B20Bus(uint8_t pin, Logger *logger);
+
+  // Register the probe with this ROM code (must be called before begin())
+  // A zeroed ROM code takes the first probe found on the bus that no other
+  // registered probe claims, in bus search order.
+  TemperatureSensor *addProbe(const DeviceAddress address);
+
+  // Initialize the bus (must be called before poll())
+  void begin();
+
+protected:
+  void startConversion() override;
+  bool collectConversion(int probe, float &celsius) override;
+
+private:
+  OneWire _oneWire;
+  DallasTemperature _sensors;
+  DeviceAddress _addresses[MAX_PROBES];
+  Logger *_logger;
+
+  static constexpr uint8_t RESOLUTION = 12;
+  static constexpr unsigned long CONVERSION_MS = 750; // tCONV at 12-bit resolution
+  static constexpr float DISCONNECTED_TEMP = -127.0f;
+  static constexpr float POWER_ON_RESET_TEMP = 85.0f;
+  static constexpr float DEFAULT_TEMP = 20.0f;
+
+  bool isAssigned(const uint8_t *address);
+  bool isClaimed(const uint8_t *address);
+  void assignUnclaimedProbes();
+  bool isValidReading(float temp);
+};
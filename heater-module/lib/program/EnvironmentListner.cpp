@@ -1,20 +1,28 @@
 #include "EnvironmentListner.h"
-#include <string>
+#include "FixedWriter.h"
 
 EnvironmentListner::EnvironmentListner(const char *name, const char *channelId, Bme280Sensor *interiorSensor,
-                                       TemperatureSensor *exteriorSensor)
-    : _interiorSensor(interiorSensor), _exteriorSensor(exteriorSensor) {
+                                       TemperatureSensor *exteriorSensor, Settings *settings)
+    : TelemetryListner(name, settings, 4), _interiorSensor(interiorSensor), _exteriorSensor(exteriorSensor) {
   this->name = name;
   this->channelId = channelId;
 }
 
-void EnvironmentListner::onReceive(std::string value) {
-  if (value.empty()) {
+void EnvironmentListner::onReceive(std::string_view command) {
+  if (command.empty()) {
     return;
   }
 
-  // Handle ENV? query
-  if (value == "ENV?") {
+  CommandReply reply;
+  handleTelemetry(command, reply);
+  if (reply.size() > 0) {
+    send(reply);
+    return;
+  }
+
+  // Handle ENV? query: answered even when nothing changed
+  if (command == "ENV?") {
+    forcePublish();
     notify();
     return;
   }
@@ -33,8 +41,23 @@ void EnvironmentListner::notify() {
   int humidityInt = static_cast<int>(humidity * 10);
   int pressureInt = static_cast<int>(pressure * 10);
   int exteriorTempInt = static_cast<int>(exteriorTemp * 10);
+  _reading = {interiorTempInt, humidityInt, pressureInt, exteriorTempInt};
+
+  const int values[] = {interiorTempInt, humidityInt, pressureInt, exteriorTempInt};
+  if (!shouldPublish(values, 4)) {
+    return;
+  }
+
+  if (binaryFrames()) {
+    const TelemetryFrame::Environment environment = {
+        TelemetryFrame::toInt16(interiorTempInt), TelemetryFrame::toUint16(humidityInt),
+        TelemetryFrame::toUint16(pressureInt), TelemetryFrame::toInt16(exteriorTempInt)};
+    publishFrame(environment);
+    return;
+  }
 
-  std::string message = "ENV:T=" + std::to_string(interiorTempInt) + ";H=" + std::to_string(humidityInt) +
-                        ";P=" + std::to_string(pressureInt) + ";EXT=" + std::to_string(exteriorTempInt);
-  send(message);
+  FixedWriter<OutboundQueue::MAX_MESSAGE_SIZE> message;
+  message.append("ENV:T=").appendInt(interiorTempInt).append(";H=").appendInt(humidityInt);
+  message.append(";P=").appendInt(pressureInt).append(";EXT=").appendInt(exteriorTempInt);
+  send(message, OutboundQueue::DROP_OLDEST);
 }
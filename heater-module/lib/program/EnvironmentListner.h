@@ -1,20 +1,34 @@
 #pragma once
 
-#include "BleListner.h"
 #include "Bme280Sensor.h"
+#include "Settings.h"
+#include "TelemetryListner.h"
 #include "TemperatureSensor.h"
 
-class EnvironmentListner : public BleListner {
+class EnvironmentListner : public TelemetryListner {
+public:
+  // Readings in tenths of their unit, as sent
+  struct Reading {
+    int temperature;
+    int humidity;
+    int pressure;
+    int exterior;
+  };
+
+private:
   Bme280Sensor *_interiorSensor;
   TemperatureSensor *_exteriorSensor;
+  Reading _reading = {0, 0, 0, 0};
 
-  void onReceive(std::string value) override;
+  void onReceive(std::string_view command) override;
 
 public:
   EnvironmentListner(const char *name, const char *channelId, Bme280Sensor *interiorSensor,
-                     TemperatureSensor *exteriorSensor);
+                     TemperatureSensor *exteriorSensor, Settings *settings);
   ~EnvironmentListner() = default;
 
-  // Send current environment data notification
+  // Send environment data notification when a reading moved past the deadband or the heartbeat expired
   void notify();
+  // Readings taken by the last notify(), shared with the snapshot channel
+  const Reading &getReading() const { return _reading; }
 };
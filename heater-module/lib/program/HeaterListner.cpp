@@ -1,34 +1,34 @@
 #include "HeaterListner.h"
+#include "FixedWriter.h"
 
 HeaterListner::HeaterListner(const char *name, const char *channelId, TemperatureRegulator *regulator,
                              Settings *settings)
-    : _regulator(regulator), _settings(new HeaterSettings(settings, name)) {
+    : TelemetryListner(name, settings, 1), _regulator(regulator), _settings(settings, name),
+      _protocol(&_settings, regulator) {
   this->name = name;
   this->channelId = channelId;
-  _protocol = new HeaterCfgProtocol(_settings, _regulator);
 
   // Load persisted state
-  int setpointTenths = _settings->getSetpoint();
+  int setpointTenths = _settings.getSetpoint();
   _regulator->setSetpoint(setpointTenths / 10.0f);
 
-  if (_settings->getRunning()) {
+  if (_settings.getRunning()) {
     _regulator->start();
   }
 }
 
-HeaterListner::~HeaterListner() {
-  delete _protocol;
-  delete _settings;
-}
-
-void HeaterListner::onReceive(std::string value) {
-  if (value.empty()) {
+void HeaterListner::onReceive(std::string_view command) {
+  if (command.empty()) {
     return;
   }
 
-  std::string response = _protocol->handle(value);
-  if (!response.empty()) {
-    send(response);
+  CommandReply reply;
+  handleTelemetry(command, reply);
+  if (reply.size() == 0) {
+    _protocol.handle(command, reply);
+  }
+  if (reply.size() > 0) {
+    send(reply);
   }
 }
 
@@ -40,7 +40,20 @@ void HeaterListner::notify() {
   int tempInt = static_cast<int>(temp * 10);
   int spInt = static_cast<int>(sp * 10);
 
-  std::string message =
-      "STATUS:T=" + std::to_string(tempInt) + ";SP=" + std::to_string(spInt) + ";RUN=" + (running ? "1" : "0");
-  send(message);
+  const int values[] = {tempInt, spInt, running ? 1 : 0};
+  if (!shouldPublish(values, 3)) {
+    return;
+  }
+
+  if (binaryFrames()) {
+    const TelemetryFrame::HeaterStatus status = {TelemetryFrame::toInt16(tempInt), TelemetryFrame::toInt16(spInt),
+                                                 running};
+    publishFrame(status);
+    return;
+  }
+
+  FixedWriter<OutboundQueue::MAX_MESSAGE_SIZE> message;
+  message.append("STATUS:T=").appendInt(tempInt).append(";SP=").appendInt(spInt);
+  message.append(";RUN=").append(running ? '1' : '0');
+  send(message, OutboundQueue::DROP_OLDEST);
 }
\ No newline at end of file
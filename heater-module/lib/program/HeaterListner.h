@@ -3,17 +3,18 @@
 #include "BleChannel.h"
 #include "HeaterCfgProtocol.h"
 #include "HeaterSettings.h"
+#include "TelemetryListner.h"
 #include "TemperatureRegulator.h"
 
-class HeaterListner : public BleListner {
+class HeaterListner : public TelemetryListner {
   TemperatureRegulator *_regulator;
-  HeaterSettings *_settings;
-  HeaterCfgProtocol *_protocol;
+  HeaterSettings _settings;
+  HeaterCfgProtocol _protocol;
 
-  void onReceive(std::string value) override;
+  void onReceive(std::string_view command) override;
 
 public:
   HeaterListner(const char *name, const char *channelId, TemperatureRegulator *regulator, Settings *settings);
-  ~HeaterListner();
+  // Sends the zone status when it changed (deadband on the temperature) or the heartbeat expired
   void notify();
 };
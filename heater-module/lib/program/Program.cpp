@@ -1,83 +1,175 @@
 #include "Program.h"
 #include "BleManager.h"
 #include "HeaterListner.h"
+#include "HeaterSettings.h"
 #include "Logger.h"
+#include "Os.h"
+#include "SnapshotListner.h"
+#include "TelemetrySettings.h"
 #include <Arduino.h>
 #include <string>
 
 #define DEEP_SLEEP_SECONDS 5
 #define ADVERTISE_SECONDS 5
 
-static constexpr uint8_t SENSOR_PINS[4] = {4, 5, 13, 15};
 static constexpr uint8_t FAN_PINS[4] = {16, 17, 18, 19};
 
+// Every DS18B20 probe (zones and exterior) shares this 1-Wire bus
+static constexpr uint8_t ONE_WIRE_PIN = 4;
+
+// ROM codes of the zone probes, then of the exterior one. A zeroed code takes the next
+// probe found on the bus: the bus logs every ROM code at boot, copy them here to pin
+// each probe to its zone.
+static const DeviceAddress ZONE_PROBE_ADDRESSES[4] = {{0}, {0}, {0}, {0}};
+static const DeviceAddress EXTERIOR_PROBE_ADDRESS = {0};
+
 // The board ties the BME280 SDO pin low, which selects the alternate I2C address.
 static constexpr uint8_t BME280_I2C_ADDRESS = BME280_ADDRESS_ALTERNATE;
 
-// Exterior temperature sensor (DS18B20) pin
-static constexpr uint8_t EXTERIOR_SENSOR_PIN = 25;
-
-// BLE channel IDs for heater channels (admin=0001, heaters=0002-0005, environment=0006)
-static const char *HEATER_NAMES[4] = {"heater_0", "heater_1", "heater_2", "heater_3"};
+// BLE channel IDs for heater channels (admin=0001, heaters=0002-0005, environment=0006, snapshot=0007)
+static constexpr const char *HEATER_NAMES[4] = {"heater_0", "heater_1", "heater_2", "heater_3"};
 static const char *HEATER_CHANNEL_IDS[4] = {"0002", "0003", "0004", "0005"};
+static_assert(HeaterSettings::fitsName(HEATER_NAMES[0]) && HeaterSettings::fitsName(HEATER_NAMES[1]) &&
+                  HeaterSettings::fitsName(HEATER_NAMES[2]) && HeaterSettings::fitsName(HEATER_NAMES[3]),
+              "Heater name too long for its NVS keys");
+
+static constexpr const char *ENVIRONMENT_NAME = "environment";
+static_assert(TelemetrySettings::fitsName(ENVIRONMENT_NAME), "Environment name too long for its NVS keys");
+
+static constexpr const char *SNAPSHOT_NAME = "snapshot";
+static_assert(TelemetrySettings::fitsName(SNAPSHOT_NAME), "Snapshot name too long for its NVS keys");
+static_assert(SnapshotListner::ZONES == 4, "The snapshot carries every heater zone");
+
+// Task periods: the probes convert in 750 ms, the PID runs at ~1 Hz, the BME280 readings
+// move slowly
+static constexpr unsigned long COMMANDS_MS = 20;
+static constexpr unsigned long PROBES_MS = 250;
+static constexpr unsigned long SETTINGS_MS = 1000;
+static constexpr unsigned long ZONES_MS = 1000;
+static constexpr unsigned long ENVIRONMENT_MS = 10000;
+
+// Radio task: log drain and sender step on the core of the NimBLE host, at the priority
+// of the loop task. Its stack covers a 512-byte chunk and the notify path.
+static constexpr unsigned long RADIO_MS = 20;
+static constexpr size_t RADIO_STACK_BYTES = 4096;
+static constexpr unsigned RADIO_PRIORITY = 1;
 
 void Program::setup(Stream &serial) {
-  _logger = new Logger(serial, Logger::INFO);
-  _logger->info("Starting heater tank module...");
+  _logger.emplace(serial, Logger::INFO);
+  LOG_INFO(_logger, "Starting heater tank module...");
 
-  _bleManager = new BleManager(_logger, _settings);
+  _bleManager.emplace(_logger.get(), _settings);
   _bleManager->setup("Heater Module", "0002");
 
+  _probeBus.emplace(ONE_WIRE_PIN, _logger.get());
+  for (int i = 0; i < 4; i++) {
+    _sensors[i] = _probeBus->addProbe(ZONE_PROBE_ADDRESSES[i]);
+  }
+  _exteriorSensor = _probeBus->addProbe(EXTERIOR_PROBE_ADDRESS);
+  _probeBus->begin();
+
+  TemperatureRegulator *regulators[4];
   for (int i = 0; i < 4; i++) {
-    _sensors[i] = new DS18B20TemperatureSensor(SENSOR_PINS[i], _logger);
-    _sensors[i]->begin();
-    _fans[i] = new PwmFan(FAN_PINS[i], i);
-    _regulators[i] = new TemperatureRegulator(_sensors[i], _fans[i], _settings, _logger);
+    _fans[i].emplace(FAN_PINS[i], i);
+    regulators[i] = &_regulators[i].emplace(_sensors[i], _fans[i].get(), _settings, _logger.get());
 
-    _heaterListners[i] = new HeaterListner(HEATER_NAMES[i], HEATER_CHANNEL_IDS[i], _regulators[i], _settings);
-    _bleManager->addChannel(_heaterListners[i]);
+    _heaterListners[i].emplace(HEATER_NAMES[i], HEATER_CHANNEL_IDS[i], regulators[i], _settings);
+    _bleManager->addChannel(_heaterListners[i].get());
   }
-  _logger->info("Temperature regulators initialized with BLE channels");
+  LOG_INFO(_logger, "Temperature regulators initialized with BLE channels");
 
   // Initialize BME280 environment sensor (interior)
-  _bme280 = new Bme280Sensor(_logger, BME280_I2C_ADDRESS);
+  _bme280.emplace(_logger.get(), BME280_I2C_ADDRESS);
   _bme280->begin();
 
-  // Initialize exterior temperature sensor (DS18B20)
-  _exteriorSensor = new DS18B20TemperatureSensor(EXTERIOR_SENSOR_PIN, _logger);
-  _exteriorSensor->begin();
+  _environmentListner.emplace(ENVIRONMENT_NAME, "0006", _bme280.get(), _exteriorSensor, _settings);
+  _bleManager->addChannel(_environmentListner.get());
+  LOG_INFO(_logger, "Environment sensors initialized (BME280 + DS18B20 exterior)");
 
-  _environmentListner = new EnvironmentListner("environment", "0006", _bme280, _exteriorSensor);
-  _bleManager->addChannel(_environmentListner);
-  _logger->info("Environment sensors initialized (BME280 + DS18B20 exterior)");
+  _snapshotListner.emplace(SNAPSHOT_NAME, "0007", regulators, _environmentListner.get(), _settings);
+  _bleManager->addChannel(_snapshotListner.get());
 
   _bleManager->start();
 
+  // The environment first, so the first snapshot carries its readings
+  _scheduler.emplace(_clock, _logger.get());
+  _scheduler->every<Program, &Program::dispatchCommands>("commands", COMMANDS_MS, this);
+  _scheduler->every<Program, &Program::pollProbes>("probes", PROBES_MS, this);
+  _scheduler->every<Program, &Program::persistSettings>("settings", SETTINGS_MS, this);
+  _scheduler->every<Program, &Program::sampleEnvironment>("environment", ENVIRONMENT_MS, this);
+  _scheduler->every<Program, &Program::regulateZones>("zones", ZONES_MS, this);
+
   _startAt = millis();
-  _logger->info("Setup done. Waiting for connection...");
+  LOG_INFO(_logger, "Setup done. Waiting for connection...");
+  _logger->flush();
+
+  // From here on the logger output and the BLE stack belong to the radio task
+  if (!os::startTask("radio", &Program::radioTask, this, os::RADIO_CORE, RADIO_STACK_BYTES, RADIO_PRIORITY)) {
+    LOG_WARN(_logger, "No radio task, serviced from the loop");
+    _scheduler->every<Program, &Program::service>("service", RADIO_MS, this);
+  }
 }
 
+// The loop task, pinned to the control core, runs the control loops and the commands
 void Program::loop() {
-  if (_bleManager->isConnected()) {
-    // Update all temperature regulators and send notifications
-    for (int i = 0; i < 4; i++) {
-      _regulators[i]->update();
-      _heaterListners[i]->notify();
-    }
+  _scheduler->tick();
+  // Sleep until the next release instead of spinning
+  delay(_scheduler->idleMs());
+}
 
-    // Send environment data notification
-    _environmentListner->notify();
+void Program::radioTask(void *program) {
+  for (;;) {
+    static_cast<Program *>(program)->service();
+    os::sleepMs(RADIO_MS);
+  }
+}
 
-    delay(110);
-    return;
+void Program::service() {
+  // Write the lines logged since the previous run, as far as the UART takes them without blocking
+  _logger->drain();
+
+  // Sender step: hand the messages queued since the previous run to the BLE stack
+  _bleManager->loop();
+
+  // Settings applied at boot: the lines logged before the reboot must reach the UART
+  if (_bleManager->rebootDue()) {
+    _logger->flush();
+    _bleManager->reboot();
   }
 
-  if (millis() - _startAt > (ADVERTISE_SECONDS * 1000)) {
-    _logger->info("Timeout -> Deep Sleep");
+  if (!_bleManager->isConnected() && millis() - _startAt > (ADVERTISE_SECONDS * 1000)) {
+    LOG_INFO(_logger, "Timeout -> Deep Sleep");
     _logger->flush();
     esp_sleep_enable_timer_wakeup(DEEP_SLEEP_SECONDS * 1000000ULL);
     esp_deep_sleep_start();
   }
+}
+
+// Collect the finished conversion of every probe and start the next one, without waiting
+void Program::pollProbes() { _probeBus->poll(); }
+
+// Run the listeners on the commands and subscriptions received since the previous run
+void Program::dispatchCommands() { _bleManager->dispatch(); }
+
+// Persist any save made outside a settings transaction
+void Program::persistSettings() { _settings->flush(); }
+
+void Program::sampleEnvironment() {
+  if (_bleManager->isConnected()) {
+    _environmentListner->notify();
+  }
+}
+
+void Program::regulateZones() {
+  if (!_bleManager->isConnected()) {
+    return;
+  }
+  // Update all temperature regulators and send notifications
+  for (int i = 0; i < 4; i++) {
+    _regulators[i]->update();
+    _heaterListners[i]->notify();
+  }
 
-  delay(500);
+  // Whole heater in one message, with the latest environment readings
+  _snapshotListner->notify();
 }
@@ -1,12 +1,16 @@
 #pragma once
 #include "BleManager.h"
 #include "Bme280Sensor.h"
-#include "DS18B20TemperatureSensor.h"
+#include "DS18B20Bus.h"
+#include "Deferred.h"
 #include "EnvironmentListner.h"
 #include "HeaterListner.h"
 #include "Logger.h"
+#include "Os.h"
 #include "PwmFan.h"
+#include "Scheduler.h"
 #include "Settings.h"
+#include "SnapshotListner.h"
 #include "TemperatureRegulator.h"
 #include <Arduino.h>
 
@@ -18,16 +22,34 @@ public:
 
 private:
   unsigned long _startAt;
-  Logger *_logger = nullptr;
-  BleManager *_bleManager = nullptr;
   Settings *_settings = nullptr;
 
-  DS18B20TemperatureSensor *_sensors[4] = {nullptr};
-  PwmFan *_fans[4] = {nullptr};
-  TemperatureRegulator *_regulators[4] = {nullptr};
-  HeaterListner *_heaterListners[4] = {nullptr};
+  // The object graph lives here, built in place by setup(): nothing is allocated on the heap
+  Deferred<Logger> _logger;
+  Deferred<BleManager> _bleManager;
 
-  Bme280Sensor *_bme280 = nullptr;
-  DS18B20TemperatureSensor *_exteriorSensor = nullptr;
-  EnvironmentListner *_environmentListner = nullptr;
+  Deferred<DS18B20Bus> _probeBus;
+  // Owned by the bus
+  TemperatureSensor *_sensors[4] = {nullptr};
+  Deferred<PwmFan> _fans[4];
+  Deferred<TemperatureRegulator> _regulators[4];
+  Deferred<HeaterListner> _heaterListners[4];
+
+  Deferred<Bme280Sensor> _bme280;
+  TemperatureSensor *_exteriorSensor = nullptr;
+  Deferred<EnvironmentListner> _environmentListner;
+  Deferred<SnapshotListner> _snapshotListner;
+
+  MillisClock _clock;
+  Deferred<Scheduler> _scheduler;
+
+  // Radio task, on the other core: logging, BLE sender step, advertising timeout
+  static void radioTask(void *program);
+  void service();
+  // Scheduled tasks, on the loop task
+  void dispatchCommands();
+  void pollProbes();
+  void persistSettings();
+  void sampleEnvironment();
+  void regulateZones();
 };
@@ -0,0 +1,86 @@
+#include "SnapshotListner.h"
+#include "FixedWriter.h"
+
+SnapshotListner::SnapshotListner(const char *name, const char *channelId, TemperatureRegulator *const *regulators,
+                                 EnvironmentListner *environment, Settings *settings)
+    : TelemetryListner(name, settings, MEASURED_FIELDS), _environment(environment) {
+  this->name = name;
+  this->channelId = channelId;
+  for (size_t i = 0; i < ZONES; i++) {
+    _regulators[i] = regulators[i];
+  }
+}
+
+void SnapshotListner::onReceive(std::string_view command) {
+  if (command.empty()) {
+    return;
+  }
+
+  CommandReply reply;
+  handleTelemetry(command, reply);
+  if (reply.size() > 0) {
+    send(reply);
+    return;
+  }
+
+  // Handle SNAP? query: answered even when nothing changed
+  if (command == "SNAP?") {
+    forcePublish();
+    notify();
+    return;
+  }
+
+  // Unknown command - no response
+}
+
+void SnapshotListner::notify() {
+  int temperatures[ZONES];
+  int setpoints[ZONES];
+  int running[ZONES];
+  int fanOutputs[ZONES];
+  for (size_t i = 0; i < ZONES; i++) {
+    temperatures[i] = static_cast<int>(_regulators[i]->getCurrentTemp() * 10);
+    setpoints[i] = static_cast<int>(_regulators[i]->getSetpoint() * 10);
+    running[i] = _regulators[i]->isRunning() ? 1 : 0;
+    fanOutputs[i] = _regulators[i]->getFanOutput();
+  }
+  const EnvironmentListner::Reading &environment = _environment->getReading();
+
+  int values[FIELDS];
+  for (size_t i = 0; i < ZONES; i++) {
+    values[i] = temperatures[i];
+    values[ZONES + i] = fanOutputs[i];
+    values[MEASURED_FIELDS + i] = setpoints[i];
+    values[MEASURED_FIELDS + ZONES + i] = running[i];
+  }
+  values[ZONES * 2] = environment.temperature;
+  values[ZONES * 2 + 1] = environment.humidity;
+  values[ZONES * 2 + 2] = environment.pressure;
+  values[ZONES * 2 + 3] = environment.exterior;
+  if (!shouldPublish(values, FIELDS)) {
+    return;
+  }
+
+  if (binaryFrames()) {
+    TelemetryFrame::HeaterSnapshot snapshot;
+    for (size_t i = 0; i < ZONES; i++) {
+      snapshot.zones[i] = {TelemetryFrame::toInt16(temperatures[i]), TelemetryFrame::toInt16(setpoints[i]),
+                           running[i] != 0, static_cast<uint8_t>(fanOutputs[i])};
+    }
+    snapshot.environment = {TelemetryFrame::toInt16(environment.temperature),
+                            TelemetryFrame::toUint16(environment.humidity),
+                            TelemetryFrame::toUint16(environment.pressure),
+                            TelemetryFrame::toInt16(environment.exterior)};
+    publishFrame(snapshot);
+    return;
+  }
+
+  FixedWriter<OutboundQueue::MAX_MESSAGE_SIZE> message;
+  message.append("SNAP:T=").appendInts(temperatures, ZONES);
+  message.append(";SP=").appendInts(setpoints, ZONES);
+  message.append(";RUN=").appendInts(running, ZONES);
+  message.append(";FAN=").appendInts(fanOutputs, ZONES);
+  message.append(";ENV=").appendInt(environment.temperature).append(',').appendInt(environment.humidity);
+  message.append(',').appendInt(environment.pressure).append(',').appendInt(environment.exterior);
+  send(message, OutboundQueue::DROP_OLDEST);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "EnvironmentListner.h"
+#include "TelemetryFrame.h"
+#include "TelemetryListner.h"
+#include "TemperatureRegulator.h"
+
+// Read-only channel carrying every zone (temperature, setpoint, running flag, fan output)
+// and the environment readings in one message per tick, so a client follows the whole
+// heater with a single subscription. Zones are still driven through their own channels.
+class SnapshotListner : public TelemetryListner {
+public:
+  static constexpr size_t ZONES = TelemetryFrame::SNAPSHOT_ZONES;
+
+private:
+  // Temperatures, fan outputs and environment are measurements, setpoints and running flags states
+  static constexpr size_t MEASURED_FIELDS = ZONES * 2 + 4;
+  static constexpr size_t FIELDS = MEASURED_FIELDS + ZONES * 2;
+
+  TemperatureRegulator *_regulators[ZONES];
+  EnvironmentListner *_environment;
+
+  void onReceive(std::string_view command) override;
+
+public:
+  // regulators holds ZONES entries, copied; environment provides the readings of the current tick
+  SnapshotListner(const char *name, const char *channelId, TemperatureRegulator *const *regulators,
+                  EnvironmentListner *environment, Settings *settings);
+  ~SnapshotListner() = default;
+
+  // Sends the snapshot when a value changed (deadband on the measurements) or the heartbeat expired,
+  // with the readings of the last environment notify().
+  void notify();
+};
@@ -1,8 +1,9 @@
 #pragma once
 
+#include "CommandTable.h"
 #include "HeaterSettings.h"
 #include "TemperatureRegulator.h"
-#include <string>
+#include <string_view>
 
 // RX commands:
 // - "CFG?"                          -> responds "CFG:KP=<kp>;KI=<ki>;KD=<kd>"
@@ -17,9 +18,18 @@ class HeaterCfgProtocol {
   HeaterSettings *_heaterSettings;
   TemperatureRegulator *_regulator;
 
-  static std::string extractValue(const std::string &cmd, const char *key);
+  static const CommandTable<HeaterCfgProtocol, 7> COMMANDS;
+
+  void readConfig(const CommandArgs &args, CommandReply &reply);
+  void writeConfig(const CommandArgs &args, CommandReply &reply);
+  void start(const CommandArgs &args, CommandReply &reply);
+  void stop(const CommandArgs &args, CommandReply &reply);
+  void readSetpoint(const CommandArgs &args, CommandReply &reply);
+  void writeSetpoint(const CommandArgs &args, CommandReply &reply);
+  void readStatus(const CommandArgs &args, CommandReply &reply);
 
 public:
   HeaterCfgProtocol(HeaterSettings *heaterSettings, TemperatureRegulator *regulator);
-  std::string handle(std::string rx);
+  // Writes the response into reply
+  void handle(std::string_view rx, CommandReply &reply);
 };
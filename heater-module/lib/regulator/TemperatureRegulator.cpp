@@ -3,31 +3,34 @@
 
 TemperatureRegulator::TemperatureRegulator(TemperatureSensor *sensor, Fan *fan, Settings *settings, Logger *logger)
     : _sensor(sensor), _fan(fan), _settings(settings), _logger(logger), _setpoint(20.0f), _integral(0.0f),
-      _lastError(0.0f), _lastUpdateTime(0), _firstUpdate(true), _running(false), _lastTemp(0.0f) {}
+      _lastError(0.0f), _lastUpdateTime(0), _firstUpdate(true), _running(false), _sampleStale(false), _lastTemp(0.0f),
+      _fanOutput(0) {}
 
 void TemperatureRegulator::setSetpoint(float celsius) {
   _setpoint = celsius;
-  _logger->info("Setpoint changed to %.1f C", celsius);
+  LOG_INFO(_logger, "Setpoint changed to %.1f C", celsius);
 }
 
 float TemperatureRegulator::getSetpoint() const { return _setpoint; }
 
 void TemperatureRegulator::start() {
   _running = true;
-  _logger->info("Regulator started");
+  LOG_INFO(_logger, "Regulator started");
 }
 
 void TemperatureRegulator::stop() {
   _running = false;
-  _fan->setSpeed(0);
-  _logger->info("Regulator stopped");
+  setFanOutput(0);
+  LOG_INFO(_logger, "Regulator stopped");
 }
 
 bool TemperatureRegulator::isRunning() const { return _running; }
 
+int TemperatureRegulator::getFanOutput() const { return _fanOutput; }
+
 float TemperatureRegulator::getCurrentTemp() {
   _lastTemp = _sensor->read();
-  _logger->debug("Temperature read: %.1f C", _lastTemp);
+  LOG_DEBUG(_logger, "Temperature read: %.1f C", _lastTemp);
   return _lastTemp;
 }
 
@@ -36,6 +39,20 @@ void TemperatureRegulator::update() {
     return;
   }
 
+  // Latest sample shared with every other reader of this tick
+  TemperatureSample sample = _sensor->sample();
+  if (!sample.isFresherThan(MAX_SAMPLE_AGE_MS)) {
+    if (!_sampleStale) {
+      LOG_WARN(_logger, "No recent temperature sample, fan stopped");
+      _sampleStale = true;
+    }
+    setFanOutput(0);
+    // Restart the time base once samples come back, so dt does not span the gap
+    _firstUpdate = true;
+    return;
+  }
+  _sampleStale = false;
+
   unsigned long currentTime = millis();
 
   // Calculate time delta in seconds
@@ -54,8 +71,7 @@ void TemperatureRegulator::update() {
     dt = 0.001f;
   }
 
-  // Read current temperature
-  float currentTemp = _sensor->read();
+  float currentTemp = sample.celsius;
 
   // Calculate error (positive when too cold, need more heating)
   float error = _setpoint - currentTemp;
@@ -84,10 +100,10 @@ void TemperatureRegulator::update() {
   int fanSpeed = clamp((int)output, 0, 255);
 
   // Apply to fan
-  _fan->setSpeed(fanSpeed);
+  setFanOutput(fanSpeed);
 
-  _logger->debug("PID: temp=%.1f, sp=%.1f, err=%.1f, P=%.1f, I=%.1f, D=%.1f, out=%d", currentTemp, _setpoint, error,
-                 pTerm, iTerm, dTerm, fanSpeed);
+  LOG_DEBUG(_logger, "PID: temp=%.1f, sp=%.1f, err=%.1f, P=%.1f, I=%.1f, D=%.1f, out=%d", currentTemp, _setpoint,
+            error, pTerm, iTerm, dTerm, fanSpeed);
 }
 
 float TemperatureRegulator::getKp() { return _settings->get(KEY_KP, DEFAULT_KP) / 100.0f; }
@@ -103,3 +119,8 @@ int TemperatureRegulator::clamp(int value, int min, int max) {
     return max;
   return value;
 }
+
+void TemperatureRegulator::setFanOutput(int speed) {
+  _fanOutput = speed;
+  _fan->setSpeed(speed);
+}
@@ -16,6 +16,8 @@ public:
   void stop();
   bool isRunning() const;
   float getCurrentTemp();
+  // Last speed applied to the fan (PWM 0-255)
+  int getFanOutput() const;
 
 private:
   TemperatureSensor *_sensor;
@@ -29,7 +31,9 @@ private:
   unsigned long _lastUpdateTime;
   bool _firstUpdate;
   bool _running;
+  bool _sampleStale;
   float _lastTemp;
+  int _fanOutput;
 
   // Settings keys
   static constexpr const char *KEY_KP = "heater_kp";
@@ -41,6 +45,10 @@ private:
   static constexpr int DEFAULT_KI = 10;   // 0.1
   static constexpr int DEFAULT_KD = 50;   // 0.5
 
+  // Oldest temperature sample the PID accepts: past it the probe is considered
+  // lost and the fan is stopped rather than driven from an outdated value
+  static constexpr unsigned long MAX_SAMPLE_AGE_MS = 5000;
+
   // Anti-windup limits
   static constexpr float INTEGRAL_MAX = 10000.0f;
   static constexpr float INTEGRAL_MIN = -10000.0f;
@@ -49,4 +57,5 @@ private:
   float getKi();
   float getKd();
   int clamp(int value, int min, int max);
+  void setFanOutput(int speed);
 };
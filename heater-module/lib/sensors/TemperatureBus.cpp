@@ -0,0 +1,48 @@
+#include "TemperatureBus.h"
+#include <Arduino.h>
+
+TemperatureBus::TemperatureBus(unsigned long conversionMs, float initialCelsius)
+    : _probeCount(0), _conversionMs(conversionMs), _startedAt(0), _converting(false), _initialCelsius(initialCelsius) {}
+
+int TemperatureBus::probeCount() const { return _probeCount; }
+
+TemperatureSensor *TemperatureBus::addProbe() {
+  if (_probeCount >= MAX_PROBES) {
+    return nullptr;
+  }
+
+  Probe *probe = &_probes[_probeCount++];
+  probe->lastSample = _initialCelsius;
+  return probe;
+}
+
+void TemperatureBus::poll() {
+  unsigned long now = millis();
+
+  if (_converting) {
+    // Conversion still running: come back on a later tick
+    if (now - _startedAt < _conversionMs) {
+      return;
+    }
+
+    for (int i = 0; i < _probeCount; i++) {
+      float celsius = 0.0f;
+      if (collectConversion(i, celsius)) {
+        _probes[i].lastSample = celsius;
+        _probes[i].sampledAt = now;
+        _probes[i].hasSample = true;
+      }
+    }
+  }
+
+  startConversion();
+  _startedAt = now;
+  _converting = true;
+}
+
+TemperatureSample TemperatureBus::Probe::sample() {
+  if (!hasSample) {
+    return {lastSample, TemperatureSample::NO_SAMPLE};
+  }
+  return {lastSample, millis() - sampledAt};
+}
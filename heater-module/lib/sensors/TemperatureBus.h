@@ -0,0 +1,52 @@
+#pragma once
+#include "TemperatureSensor.h"
+
+// Several temperature probes sharing one bus and one conversion cycle.
+// poll() broadcasts a single conversion to every probe and returns; a later poll()
+// collects every probe's result in one pass once the conversion time has elapsed,
+// then starts the next conversion.
+// Each probe is exposed as its own TemperatureSensor, whose read() never touches
+// the hardware: it returns the latest completed sample of that probe, so every
+// reader of a loop tick shares the same acquisition. sample() tells its age.
+class TemperatureBus {
+public:
+  static constexpr int MAX_PROBES = 8;
+
+  TemperatureBus(unsigned long conversionMs, float initialCelsius);
+  virtual ~TemperatureBus() = default;
+
+  // Advance the conversion state machine (call once per loop tick, never blocks)
+  void poll();
+
+  int probeCount() const;
+
+protected:
+  // Register the next probe of the bus
+  // Returns nullptr when MAX_PROBES are already registered
+  TemperatureSensor *addProbe();
+
+  // Ask every probe of the bus to start a conversion, without waiting for it
+  virtual void startConversion() = 0;
+
+  // Fetch the result of a finished conversion for one probe
+  // Returns false when the probe answered with an unusable value
+  virtual bool collectConversion(int probe, float &celsius) = 0;
+
+private:
+  class Probe : public TemperatureSensor {
+  public:
+    float lastSample = 0.0f;
+    unsigned long sampledAt = 0;
+    bool hasSample = false;
+
+    float read() override { return lastSample; }
+    TemperatureSample sample() override;
+  };
+
+  Probe _probes[MAX_PROBES];
+  int _probeCount;
+  unsigned long _conversionMs;
+  unsigned long _startedAt;
+  bool _converting;
+  float _initialCelsius;
+};
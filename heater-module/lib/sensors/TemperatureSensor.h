@@ -1,9 +1,23 @@
 #pragma once
 
+struct TemperatureSample {
+  // Age reported by a sensor that has not acquired anything yet
+  static constexpr unsigned long NO_SAMPLE = ~0UL;
+
+  float celsius;
+  unsigned long ageMs; // Time elapsed since the value was acquired
+
+  bool isFresherThan(unsigned long maxAgeMs) const { return ageMs <= maxAgeMs; }
+};
+
 class TemperatureSensor {
 public:
   virtual ~TemperatureSensor() = default;
 
   // Returns the current temperature in degrees Celsius
   virtual float read() = 0;
+
+  // Returns the current temperature along with how long ago it was acquired
+  // Sensors acquiring on every call report a zero age
+  virtual TemperatureSample sample() { return {read(), 0}; }
 };
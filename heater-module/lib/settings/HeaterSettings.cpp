@@ -1,52 +1,31 @@
 #include "HeaterSettings.h"
-#include <string>
 
-int HeaterSettings::getKp() {
-  const std::string key = _name + "_kp";
-  return _settings->get(key.c_str(), DEFAULT_KP);
-}
-
-void HeaterSettings::setKp(int value) {
-  const std::string key = _name + "_kp";
-  _settings->save(key.c_str(), value);
-}
-
-int HeaterSettings::getKi() {
-  const std::string key = _name + "_ki";
-  return _settings->get(key.c_str(), DEFAULT_KI);
-}
+int HeaterSettings::getKp() { return _settings->get(_kpKey.c_str(), DEFAULT_KP); }
 
-void HeaterSettings::setKi(int value) {
-  const std::string key = _name + "_ki";
-  _settings->save(key.c_str(), value);
-}
+int HeaterSettings::getKi() { return _settings->get(_kiKey.c_str(), DEFAULT_KI); }
 
-int HeaterSettings::getKd() {
-  const std::string key = _name + "_kd";
-  return _settings->get(key.c_str(), DEFAULT_KD);
-}
+int HeaterSettings::getKd() { return _settings->get(_kdKey.c_str(), DEFAULT_KD); }
 
-void HeaterSettings::setKd(int value) {
-  const std::string key = _name + "_kd";
-  _settings->save(key.c_str(), value);
+void HeaterSettings::setPid(int kp, int ki, int kd) {
+  _settings->beginTransaction();
+  _settings->save(_kpKey.c_str(), kp);
+  _settings->save(_kiKey.c_str(), ki);
+  _settings->save(_kdKey.c_str(), kd);
+  _settings->commit();
 }
 
-int HeaterSettings::getSetpoint() {
-  const std::string key = _name + "_sp";
-  return _settings->get(key.c_str(), DEFAULT_SP);
-}
+int HeaterSettings::getSetpoint() { return _settings->get(_spKey.c_str(), DEFAULT_SP); }
 
 void HeaterSettings::setSetpoint(int tenths) {
-  const std::string key = _name + "_sp";
-  _settings->save(key.c_str(), tenths);
+  _settings->beginTransaction();
+  _settings->save(_spKey.c_str(), tenths);
+  _settings->commit();
 }
 
-bool HeaterSettings::getRunning() {
-  const std::string key = _name + "_run";
-  return _settings->get(key.c_str(), DEFAULT_RUN) != 0;
-}
+bool HeaterSettings::getRunning() { return _settings->get(_runKey.c_str(), DEFAULT_RUN) != 0; }
 
 void HeaterSettings::setRunning(bool value) {
-  const std::string key = _name + "_run";
-  _settings->save(key.c_str(), value ? 1 : 0);
-}
\ No newline at end of file
+  _settings->beginTransaction();
+  _settings->save(_runKey.c_str(), value ? 1 : 0);
+  _settings->commit();
+}
@@ -1,24 +1,41 @@
 #pragma once
 
 #include "Settings.h"
+#include "SettingsKey.h"
 #include <string>
 
 class HeaterSettings {
+  static constexpr const char *KP_SUFFIX = "_kp";
+  static constexpr const char *KI_SUFFIX = "_ki";
+  static constexpr const char *KD_SUFFIX = "_kd";
+  static constexpr const char *SP_SUFFIX = "_sp";
+  static constexpr const char *RUN_SUFFIX = "_run";
+
   Settings *_settings = nullptr;
-  std::string _name;
+  SettingsKey _kpKey;
+  SettingsKey _kiKey;
+  SettingsKey _kdKey;
+  SettingsKey _spKey;
+  SettingsKey _runKey;
 
 public:
-  HeaterSettings(Settings *settings, const std::string &name) : _settings(settings), _name(name) {}
-  HeaterSettings(Settings *settings, const char *name) : _settings(settings), _name(name) {}
+  HeaterSettings(Settings *settings, const std::string &name) : HeaterSettings(settings, name.c_str()) {}
+  HeaterSettings(Settings *settings, const char *name)
+      : _settings(settings), _kpKey(name, KP_SUFFIX), _kiKey(name, KI_SUFFIX), _kdKey(name, KD_SUFFIX),
+        _spKey(name, SP_SUFFIX), _runKey(name, RUN_SUFFIX) {}
+
+  // True when every key of a heater with this name fits the NVS limit
+  static constexpr bool fitsName(const char *name) {
+    return SettingsKey::fits(name, KP_SUFFIX) && SettingsKey::fits(name, KI_SUFFIX) &&
+           SettingsKey::fits(name, KD_SUFFIX) && SettingsKey::fits(name, SP_SUFFIX) &&
+           SettingsKey::fits(name, RUN_SUFFIX);
+  }
 
   int getKp();
-  void setKp(int value);
-
   int getKi();
-  void setKi(int value);
-
   int getKd();
-  void setKd(int value);
+  // Persists the three gains together, in one settings transaction
+  void setPid(int kp, int ki, int kd);
 
   int getSetpoint();
   void setSetpoint(int tenths);
@@ -1,11 +1,15 @@
 #include "Arduino.h"
+#include "CachedSettings.h"
 #include "Esp32Settings.h"
 #include "Program.h"
 
 // Rates for serial communication
 #define STANDARD_BAUD 9600
 
-static Program program(new Esp32Settings("ht-settings"));
+// Statically allocated, like the whole object graph Program owns
+static Esp32Settings nvsSettings("ht-settings");
+static CachedSettings settings(&nvsSettings);
+static Program program(&settings);
 
 void setup() {
   Serial.begin(STANDARD_BAUD);
@@ -21,7 +21,15 @@ public:
     return defaultValue;
   }
   void save(const char *key, const char *value) override { str_values[std::string(key)] = value; }
+  void beginTransaction() override { transactionDepth++; }
+  void commit() override {
+    if (--transactionDepth == 0) {
+      commits++;
+    }
+  }
 
   std::map<std::string, int> int_values;
   std::map<std::string, std::string> str_values;
+  int transactionDepth = 0;
+  int commits = 0; // Outermost commits only
 };
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include "CommandTable.h"
+#include <string>
+#include <string_view>
+
+// Response of protocol to command, as a string for the assertions
+template <typename Protocol> std::string replyTo(Protocol &protocol, std::string_view command) {
+  CommandReply reply;
+  protocol.handle(command, reply);
+  return std::string(reply.view());
+}
@@ -1,7 +1,12 @@
+#include "CachedSettings.h"
+#include "ChunkedSender.h"
 #include "HeaterCfgProtocol.h"
+#include "TelemetryProtocol.h"
 #include "../ArduinoMacroGuard.h"
+#include "../CountingAllocator.h"
 #include "../FakeSettings.h"
 #include "../MockStream.h"
+#include "../ReplyTo.h"
 #include <ArduinoFake.h>
 #include <gtest/gtest.h>
 #include <string>
@@ -69,7 +74,7 @@ TEST_F(HeaterCfgProtocolTest, CfgQueryRespondsWithCurrentValues) {
   settings->int_values["test_ki"] = 25;
   settings->int_values["test_kd"] = 75;
 
-  EXPECT_EQ(protocol->handle("CFG?"), "CFG:KP=1500;KI=25;KD=75");
+  EXPECT_EQ(replyTo(*protocol, "CFG?"), "CFG:KP=1500;KI=25;KD=75");
 }
 
 TEST_F(HeaterCfgProtocolTest, CfgQueryUsesDefaultValues) {
@@ -79,7 +84,7 @@ TEST_F(HeaterCfgProtocolTest, CfgQueryUsesDefaultValues) {
   HeaterSettings *freshSettings = new HeaterSettings(settings, "fresh");
   HeaterCfgProtocol *freshProtocol = new HeaterCfgProtocol(freshSettings, regulator);
 
-  std::string response = freshProtocol->handle("CFG?");
+  std::string response = replyTo(*freshProtocol, "CFG?");
   EXPECT_EQ(response, "CFG:KP=1000;KI=10;KD=50");
 
   delete freshProtocol;
@@ -88,69 +93,75 @@ TEST_F(HeaterCfgProtocolTest, CfgQueryUsesDefaultValues) {
 
 // CFG: write tests
 TEST_F(HeaterCfgProtocolTest, CfgWritePersistsAndRespondsOk) {
-  EXPECT_EQ(protocol->handle("CFG:KP=2000;KI=50;KD=100"), "OK");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=2000;KI=50;KD=100"), "OK");
   EXPECT_EQ(settings->int_values["test_kp"], 2000);
   EXPECT_EQ(settings->int_values["test_ki"], 50);
   EXPECT_EQ(settings->int_values["test_kd"], 100);
 }
 
+TEST_F(HeaterCfgProtocolTest, CfgWritePersistsTheThreeGainsInOneCommit) {
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=2000;KI=50;KD=100"), "OK");
+  EXPECT_EQ(settings->commits, 1);
+  EXPECT_EQ(settings->transactionDepth, 0);
+}
+
 TEST_F(HeaterCfgProtocolTest, CfgWriteRejectsMissingFields) {
-  EXPECT_EQ(protocol->handle("CFG:KP=100"), "ERR_CFG_FMT");
-  EXPECT_EQ(protocol->handle("CFG:KI=100"), "ERR_CFG_FMT");
-  EXPECT_EQ(protocol->handle("CFG:KD=100"), "ERR_CFG_FMT");
-  EXPECT_EQ(protocol->handle("CFG:KP=100;KI=100"), "ERR_CFG_FMT");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=100"), "ERR_CFG_FMT");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KI=100"), "ERR_CFG_FMT");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KD=100"), "ERR_CFG_FMT");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=100;KI=100"), "ERR_CFG_FMT");
 }
 
 TEST_F(HeaterCfgProtocolTest, CfgWriteRejectsNonNumeric) {
-  EXPECT_EQ(protocol->handle("CFG:KP=abc;KI=100;KD=100"), "ERR_CFG_NUM");
-  EXPECT_EQ(protocol->handle("CFG:KP=100;KI=-1;KD=100"), "ERR_CFG_NUM");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=abc;KI=100;KD=100"), "ERR_CFG_NUM");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=100;KI=-1;KD=100"), "ERR_CFG_NUM");
 }
 
 TEST_F(HeaterCfgProtocolTest, CfgWriteRejectsOutOfRange) {
-  EXPECT_EQ(protocol->handle("CFG:KP=0;KI=100;KD=100"), "ERR_CFG_RANGE");
-  EXPECT_EQ(protocol->handle("CFG:KP=100;KI=0;KD=100"), "ERR_CFG_RANGE");
-  EXPECT_EQ(protocol->handle("CFG:KP=100;KI=100;KD=0"), "ERR_CFG_RANGE");
-  EXPECT_EQ(protocol->handle("CFG:KP=99999;KI=100;KD=100"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=0;KI=100;KD=100"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=100;KI=0;KD=100"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=100;KI=100;KD=0"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(*protocol, "CFG:KP=99999;KI=100;KD=100"), "ERR_CFG_RANGE");
 }
 
 // START/STOP tests
 TEST_F(HeaterCfgProtocolTest, StartReturnsOkAndStartsRegulator) {
   EXPECT_FALSE(regulator->isRunning());
-  EXPECT_EQ(protocol->handle("START"), "OK");
+  EXPECT_EQ(replyTo(*protocol, "START"), "OK");
   EXPECT_TRUE(regulator->isRunning());
 }
 
 TEST_F(HeaterCfgProtocolTest, StopReturnsOkAndStopsRegulator) {
   regulator->start();
   EXPECT_TRUE(regulator->isRunning());
-  EXPECT_EQ(protocol->handle("STOP"), "OK");
+  EXPECT_EQ(replyTo(*protocol, "STOP"), "OK");
   EXPECT_FALSE(regulator->isRunning());
 }
 
 // SP? tests
 TEST_F(HeaterCfgProtocolTest, SpQueryReturnsSetpoint) {
   regulator->setSetpoint(25.5f);
-  EXPECT_EQ(protocol->handle("SP?"), "SP:255");
+  EXPECT_EQ(replyTo(*protocol, "SP?"), "SP:255");
 }
 
 TEST_F(HeaterCfgProtocolTest, SpQueryReturnsDefaultSetpoint) {
   // Default setpoint is 20.0
-  EXPECT_EQ(protocol->handle("SP?"), "SP:200");
+  EXPECT_EQ(replyTo(*protocol, "SP?"), "SP:200");
 }
 
 // SP: write tests
 TEST_F(HeaterCfgProtocolTest, SpWriteSetsSetpointAndRespondsOk) {
-  EXPECT_EQ(protocol->handle("SP:300"), "OK");
+  EXPECT_EQ(replyTo(*protocol, "SP:300"), "OK");
   EXPECT_FLOAT_EQ(regulator->getSetpoint(), 30.0f);
 }
 
 TEST_F(HeaterCfgProtocolTest, SpWriteRejectsNonNumeric) {
-  EXPECT_EQ(protocol->handle("SP:abc"), "ERR_SP_NUM");
+  EXPECT_EQ(replyTo(*protocol, "SP:abc"), "ERR_SP_NUM");
 }
 
 TEST_F(HeaterCfgProtocolTest, SpWriteRejectsOutOfRange) {
-  EXPECT_EQ(protocol->handle("SP:-10"), "ERR_SP_NUM");
-  EXPECT_EQ(protocol->handle("SP:600"), "ERR_SP_RANGE");
+  EXPECT_EQ(replyTo(*protocol, "SP:-10"), "ERR_SP_NUM");
+  EXPECT_EQ(replyTo(*protocol, "SP:600"), "ERR_SP_RANGE");
 }
 
 TEST_F(HeaterCfgProtocolTest, StatusQueryReturnsStatus) {
@@ -158,7 +169,7 @@ TEST_F(HeaterCfgProtocolTest, StatusQueryReturnsStatus) {
   regulator->setSetpoint(25.0f);
   regulator->start();
 
-  std::string status = protocol->handle("STATUS?");
+  std::string status = replyTo(*protocol, "STATUS?");
   EXPECT_EQ(status, "STATUS:T=225;SP=250;RUN=1");
 }
 
@@ -166,12 +177,87 @@ TEST_F(HeaterCfgProtocolTest, StatusQueryWhenStopped) {
   sensor->temperature = 20.0f;
   regulator->setSetpoint(20.0f);
 
-  std::string status = protocol->handle("STATUS?");
+  std::string status = replyTo(*protocol, "STATUS?");
   EXPECT_EQ(status, "STATUS:T=200;SP=200;RUN=0");
 }
 
 // Unknown command tests
 TEST_F(HeaterCfgProtocolTest, UnknownCommandReturnsEmptyString) {
-  EXPECT_EQ(protocol->handle("PING"), "");
-  EXPECT_EQ(protocol->handle("INVALID"), "");
+  EXPECT_EQ(replyTo(*protocol, "PING"), "");
+  EXPECT_EQ(replyTo(*protocol, "INVALID"), "");
+}
+
+TEST_F(HeaterCfgProtocolTest, WritesAndErrorsDoNotAllocate) {
+  const char *commands[] = {"CFG:KP=1200;KI=20;KD=60", "CFG:KP=abc;KI=20;KD=60", "CFG:KP=1200", "SP:215", "SP:9999",
+                            "SP:-5",                   "START",                  "STOP",        "NOPE"};
+  // First pass settles the settings keys, the second one must not touch the heap
+  for (const char *command : commands) {
+    replyTo(*protocol, command);
+  }
+
+  const int before = CountingAllocator::allocations();
+  for (const char *command : commands) {
+    replyTo(*protocol, command);
+  }
+
+  EXPECT_EQ(CountingAllocator::allocations(), before);
+}
+
+// Sender counting the bytes handed to the stack, without storing them
+class CountingSender : public ChunkedSender {
+public:
+  size_t bytes = 0;
+
+protected:
+  bool transmit(const uint8_t *, size_t length) override {
+    bytes += length;
+    return true;
+  }
+};
+
+// What a heater listener does per tick after boot: dispatch the received commands,
+// publish the STATUS line and flush the chunks, over the settings cache
+TEST_F(HeaterCfgProtocolTest, DispatchAndNotifyTickDoesNotAllocate) {
+  CachedSettings cache(settings);
+  HeaterSettings cachedHeater(&cache, "test");
+  HeaterCfgProtocol heater(&cachedHeater, regulator);
+  TelemetrySettings telemetrySettings(&cache, "test");
+  TelemetryGate gate(1);
+  TelemetryProtocol telemetry(&telemetrySettings, &gate);
+  CountingSender sender;
+  const char *commands[] = {"TLM:DB=5;HB=30", "TLM?", "CFG?", "CFG:KP=1200;KI=20;KD=60", "SP:215", "SP?", "NOPE"};
+  auto tick = [&](unsigned long nowMs) {
+    for (const char *command : commands) {
+      CommandReply reply;
+      telemetry.handle(command, reply);
+      if (reply.size() == 0) {
+        heater.handle(command, reply);
+      }
+      if (reply.size() > 0) {
+        sender.send(reply.data(), reply.size());
+      }
+    }
+    const int temp = static_cast<int>(regulator->getCurrentTemp() * 10);
+    const int values[] = {temp, static_cast<int>(regulator->getSetpoint() * 10), regulator->isRunning() ? 1 : 0};
+    if (gate.shouldPublish(values, 3, nowMs)) {
+      FixedWriter<OutboundQueue::MAX_MESSAGE_SIZE> message;
+      message.append("STATUS:T=").appendInt(values[0]).append(";SP=").appendInt(values[1]);
+      message.append(";RUN=").append(values[2] ? '1' : '0');
+      ASSERT_FALSE(message.overflowed());
+      sender.send(message.data(), message.size(), OutboundQueue::DROP_OLDEST);
+    }
+    sender.flush();
+    cache.flush();
+  };
+  // The first tick loads the keys into the cache, from then on nothing touches the heap
+  tick(0);
+
+  const int before = CountingAllocator::allocations();
+  tick(60000);
+  sensor->temperature = 25.0f;
+  tick(61000);
+
+  EXPECT_EQ(CountingAllocator::allocations(), before);
+  EXPECT_GT(sender.bytes, 0u);
+  EXPECT_EQ(sender.getDropCount(), 0ul);
 }
@@ -11,7 +11,13 @@ using namespace fakeit;
 class MockTemperatureSensor : public TemperatureSensor {
 public:
   float temperature = 20.0f;
+  unsigned long ageMs = 0;
+  int reads = 0;
   float read() override { return temperature; }
+  TemperatureSample sample() override {
+    reads++;
+    return {temperature, ageMs};
+  }
 };
 
 // Mock Fan
@@ -131,3 +137,56 @@ TEST_F(TemperatureRegulatorTest, UsesSettingsForPIDGains) {
   regulator->update();
   EXPECT_EQ(20, fan->speed);
 }
+
+TEST_F(TemperatureRegulatorTest, UpdateReadsTheSensorOnce) {
+  sensor->temperature = 15.0f;
+  regulator->setSetpoint(25.0f);
+  regulator->start();
+  regulator->update();
+  EXPECT_EQ(1, sensor->reads);
+}
+
+TEST_F(TemperatureRegulatorTest, StaleSampleStopsTheFan) {
+  sensor->temperature = 15.0f;
+  regulator->setSetpoint(25.0f);
+  regulator->start();
+  regulator->update();
+  EXPECT_GT(fan->speed, 0);
+
+  sensor->ageMs = 10000;
+  regulator->update();
+  EXPECT_EQ(0, fan->speed);
+}
+
+TEST_F(TemperatureRegulatorTest, MissingSampleKeepsTheFanStopped) {
+  sensor->temperature = 15.0f;
+  sensor->ageMs = TemperatureSample::NO_SAMPLE;
+  regulator->setSetpoint(25.0f);
+  regulator->start();
+  regulator->update();
+  EXPECT_EQ(0, fan->speed);
+}
+
+TEST_F(TemperatureRegulatorTest, RegulationResumesWhenSamplesComeBack) {
+  sensor->temperature = 15.0f;
+  sensor->ageMs = 10000;
+  regulator->setSetpoint(25.0f);
+  regulator->start();
+  regulator->update();
+  EXPECT_EQ(0, fan->speed);
+
+  sensor->ageMs = 0;
+  regulator->update();
+  EXPECT_GT(fan->speed, 0);
+}
+
+TEST_F(TemperatureRegulatorTest, FanOutputReportsTheAppliedSpeed) {
+  sensor->temperature = 0.0f;
+  regulator->setSetpoint(50.0f);
+  regulator->start();
+  regulator->update();
+  EXPECT_EQ(255, regulator->getFanOutput());
+
+  regulator->stop();
+  EXPECT_EQ(0, regulator->getFanOutput());
+}
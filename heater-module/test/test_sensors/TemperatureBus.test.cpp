@@ -0,0 +1,169 @@
+#include "TemperatureBus.h"
+#include "../ArduinoMacroGuard.h"
+#include <ArduinoFake.h>
+#include <gtest/gtest.h>
+
+using namespace fakeit;
+
+// Bus whose conversions finish whenever the test says so
+class FakeTemperatureBus : public TemperatureBus {
+public:
+  FakeTemperatureBus() : TemperatureBus(750, 20.0f) {}
+
+  using TemperatureBus::addProbe;
+
+  float nextValues[MAX_PROBES] = {21.5f, 18.0f, 5.5f};
+  bool nextValid[MAX_PROBES] = {true, true, true};
+  int conversions = 0;
+  int collected = 0;
+
+protected:
+  void startConversion() override { conversions++; }
+  bool collectConversion(int probe, float &celsius) override {
+    collected++;
+    celsius = nextValues[probe];
+    return nextValid[probe];
+  }
+};
+
+class TemperatureBusTest : public ::testing::Test {
+protected:
+  FakeTemperatureBus bus;
+  TemperatureSensor *zone = nullptr;
+  TemperatureSensor *other = nullptr;
+  TemperatureSensor *exterior = nullptr;
+
+  void SetUp() override {
+    ArduinoFake().ClearInvocationHistory();
+    at(0);
+    zone = bus.addProbe();
+    other = bus.addProbe();
+    exterior = bus.addProbe();
+  }
+
+  void at(unsigned long ms) { When(Method(ArduinoFake(), millis)).AlwaysReturn(ms); }
+};
+
+TEST_F(TemperatureBusTest, ProbesReadInitialValueBeforeFirstConversion) {
+  EXPECT_FLOAT_EQ(20.0f, zone->read());
+
+  bus.poll();
+  EXPECT_FLOAT_EQ(20.0f, zone->read());
+  EXPECT_FLOAT_EQ(20.0f, exterior->read());
+  EXPECT_EQ(1, bus.conversions);
+  EXPECT_EQ(0, bus.collected);
+}
+
+TEST_F(TemperatureBusTest, PollDoesNotCollectBeforeConversionTime) {
+  bus.poll();
+
+  // 110 ms loop ticks: the conversion is still running for the next six of them
+  for (unsigned long now = 110; now < 750; now += 110) {
+    at(now);
+    bus.poll();
+  }
+
+  EXPECT_EQ(1, bus.conversions);
+  EXPECT_EQ(0, bus.collected);
+  EXPECT_FLOAT_EQ(20.0f, zone->read());
+}
+
+TEST_F(TemperatureBusTest, OneConversionServesEveryProbe) {
+  bus.poll();
+
+  at(750);
+  bus.poll();
+
+  EXPECT_EQ(3, bus.collected);
+  EXPECT_EQ(2, bus.conversions);
+  EXPECT_FLOAT_EQ(21.5f, zone->read());
+  EXPECT_FLOAT_EQ(18.0f, other->read());
+  EXPECT_FLOAT_EQ(5.5f, exterior->read());
+}
+
+TEST_F(TemperatureBusTest, InvalidConversionOnlyKeepsThatProbeOnItsLastSample) {
+  bus.poll();
+  at(750);
+  bus.poll();
+
+  bus.nextValues[1] = -127.0f;
+  bus.nextValid[1] = false;
+  bus.nextValues[0] = 22.0f;
+  at(1500);
+  bus.poll();
+
+  EXPECT_FLOAT_EQ(22.0f, zone->read());
+  EXPECT_FLOAT_EQ(18.0f, other->read());
+}
+
+TEST_F(TemperatureBusTest, SampleReportsNoAgeBeforeFirstConversion) {
+  bus.poll();
+
+  EXPECT_EQ(TemperatureSample::NO_SAMPLE, zone->sample().ageMs);
+  EXPECT_FALSE(zone->sample().isFresherThan(5000));
+}
+
+TEST_F(TemperatureBusTest, SampleAgesUntilTheNextConversionIsCollected) {
+  bus.poll();
+  at(750);
+  bus.poll();
+
+  at(1000);
+  TemperatureSample sample = zone->sample();
+  EXPECT_FLOAT_EQ(21.5f, sample.celsius);
+  EXPECT_EQ(250u, sample.ageMs);
+
+  at(1500);
+  bus.poll();
+  EXPECT_EQ(0u, zone->sample().ageMs);
+}
+
+TEST_F(TemperatureBusTest, SampleKeepsAgingWhileTheProbeFails) {
+  bus.poll();
+  at(750);
+  bus.poll();
+
+  bus.nextValid[0] = false;
+  at(1500);
+  bus.poll();
+  at(2250);
+  bus.poll();
+
+  EXPECT_EQ(1500u, zone->sample().ageMs);
+  EXPECT_EQ(0u, other->sample().ageMs);
+}
+
+TEST_F(TemperatureBusTest, ReadNeverTouchesTheBus) {
+  bus.poll();
+  at(5000);
+
+  for (int i = 0; i < 10; i++) {
+    zone->read();
+    exterior->read();
+  }
+
+  EXPECT_EQ(1, bus.conversions);
+  EXPECT_EQ(0, bus.collected);
+}
+
+TEST_F(TemperatureBusTest, AddProbeFailsOnceTheBusIsFull) {
+  for (int i = bus.probeCount(); i < TemperatureBus::MAX_PROBES; i++) {
+    EXPECT_NE(nullptr, bus.addProbe());
+  }
+
+  EXPECT_EQ(nullptr, bus.addProbe());
+  EXPECT_EQ(TemperatureBus::MAX_PROBES, bus.probeCount());
+}
+
+TEST_F(TemperatureBusTest, LoopTickNeverBlocks) {
+  // A full minute of 110 ms ticks: a conversion completes every 7th tick (770 ms)
+  for (unsigned long now = 0; now <= 60000; now += 110) {
+    at(now);
+    bus.poll();
+    zone->read();
+  }
+
+  Verify(Method(ArduinoFake(), delay)).Never();
+  EXPECT_EQ(77 * 3, bus.collected);
+  EXPECT_EQ(78, bus.conversions);
+}
@@ -0,0 +1,48 @@
+#include "HeaterSettings.h"
+#include "../CountingAllocator.h"
+#include "../FakeSettings.h"
+#include "CachedSettings.h"
+#include <gtest/gtest.h>
+
+TEST(HeaterSettings, KeysArePrefixedWithHeaterName) {
+  FakeSettings settings;
+  HeaterSettings heater(&settings, "heater_2");
+
+  heater.setPid(1, 2, 3);
+  heater.setSetpoint(215);
+  heater.setRunning(true);
+
+  EXPECT_EQ(settings.int_values["heater_2_kp"], 1);
+  EXPECT_EQ(settings.int_values["heater_2_ki"], 2);
+  EXPECT_EQ(settings.int_values["heater_2_kd"], 3);
+  EXPECT_EQ(settings.int_values["heater_2_sp"], 215);
+  EXPECT_EQ(settings.int_values["heater_2_run"], 1);
+}
+
+TEST(HeaterSettings, FitsNameAllowsElevenCharacters) {
+  static_assert(HeaterSettings::fitsName("heater_0"), "heater_0_run fits");
+  static_assert(HeaterSettings::fitsName("living_room"), "living_room_run is 15 characters");
+  static_assert(!HeaterSettings::fitsName("living_rooms"), "living_rooms_run is 16 characters");
+}
+
+TEST(HeaterSettings, CachedLookupsDoNotAllocate) {
+  FakeSettings backend;
+  CachedSettings settings(&backend);
+  HeaterSettings heater(&settings, "heater_0");
+  // First reads fill the cache
+  heater.getKp();
+  heater.getKi();
+  heater.getKd();
+  heater.getSetpoint();
+
+  const int before = CountingAllocator::allocations();
+  int sum = 0;
+  for (int i = 0; i < 100; i++) {
+    sum += heater.getKp() + heater.getKi() + heater.getKd() + heater.getSetpoint();
+  }
+  const int allocations = CountingAllocator::allocations() - before;
+
+  EXPECT_EQ(allocations, 0);
+  EXPECT_EQ(sum, 100 * (HeaterSettings::DEFAULT_KP + HeaterSettings::DEFAULT_KI + HeaterSettings::DEFAULT_KD +
+                        HeaterSettings::DEFAULT_SP));
+}
@@ -0,0 +1,47 @@
+# PlatformIO post-build script: RAM report of the firmware.
+# Prints the static RAM of each DRAM section, then the largest objects in it. Program and
+# its components are statically allocated, so their footprint is known at build time and
+# shows up here (the "program" object) instead of in the heap at run time.
+# Enabled by the esp32 envs: extra_scripts = post:../scripts/ram_report.py
+import subprocess
+
+Import("env")  # noqa: F821 (SCons global)
+
+RAM_SECTIONS = (".dram0.data", ".dram0.bss", ".noinit")
+# nm types of initialized and zeroed data, global or local
+RAM_SYMBOL_TYPES = "bBdD"
+TOP_SYMBOLS = 15
+
+
+def run(tool, *args):
+    return subprocess.run([tool, *args], capture_output=True, text=True, check=True).stdout
+
+
+def ram_report(source, target, env):
+    elf = str(target[0])
+    size_tool = env.subst("$SIZETOOL")
+    nm_tool = size_tool[: -len("size")] + "nm"
+
+    sections = {}
+    for line in run(size_tool, "-A", elf).splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0] in RAM_SECTIONS:
+            sections[fields[0]] = int(fields[1])
+
+    symbols = []
+    for line in run(nm_tool, "-C", "-S", "--size-sort", elf).splitlines():
+        fields = line.split(maxsplit=3)
+        if len(fields) == 4 and fields[2] in RAM_SYMBOL_TYPES:
+            symbols.append((int(fields[1], 16), fields[3]))
+    symbols.sort(reverse=True)
+
+    print("RAM report (%s)" % env.subst("$PIOENV"))
+    for name in RAM_SECTIONS:
+        print("  %-12s %8d bytes" % (name, sections.get(name, 0)))
+    print("  %-12s %8d bytes" % ("total", sum(sections.values())))
+    print("  Largest objects:")
+    for size, name in symbols[:TOP_SYMBOLS]:
+        print("  %8d  %s" % (size, name))
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", ram_report)  # noqa: F821
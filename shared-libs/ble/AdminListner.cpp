@@ -1,28 +1,26 @@
 #include "AdminListner.h"
 #include <Arduino.h>
-#include <NimBLEDevice.h>
 
-void AdminListener::onReceive(std::string value) {
-  _logger->debug("Received command: %s", value.c_str());
-  const std::string ack = _protocol->handle(value);
-  const bool shouldReboot = (ack == "OK");
+void AdminListener::onReceive(std::string_view command) {
+  CommandReply ack;
+  _protocol.handle(command, ack);
+  const bool shouldReboot = (ack.view() == "OK");
 
   // Send ACK to the phone (Admin TX characteristic)
   // Note: keep it short (<20 bytes) for maximum BLE compatibility.
-  _logger->info("Admin command ACK: %s", ack.c_str());
+  LOG_INFO(_logger, "Admin command ACK: %s", ack.data());
   this->send(ack);
 
-  if (!shouldReboot) {
+  // Already requested: keep the first deadline
+  if (!shouldReboot || _rebootRequested.load(std::memory_order_relaxed)) {
     return;
   }
 
-  // Delete old link (mandatory) to force client to refresh/reconnect with new
-  // PIN.
-  NimBLEDevice::deleteAllBonds();
+  LOG_INFO(_logger, "Reboot to apply new settings...");
+  _rebootRequestedAt = millis();
+  _rebootRequested.store(true, std::memory_order_release);
+}
 
-  // Give the BLE stack time to flush the notification before rebooting.
-  delay(500);
-
-  _logger->info("Reboot to apply new settings...");
-  ESP.restart();
+bool AdminListener::rebootDue(unsigned long nowMs) const {
+  return _rebootRequested.load(std::memory_order_acquire) && nowMs - _rebootRequestedAt >= REBOOT_DELAY_MS;
 }
\ No newline at end of file
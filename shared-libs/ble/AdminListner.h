@@ -5,18 +5,31 @@
 #include "BleListner.h"
 #include "Logger.h"
 #include "Settings.h"
-#include <string>
+#include <atomic>
+#include <string_view>
 
+// A saved setting only applies at boot: the reboot is requested here, on the control
+// task, and carried out by the service step once the ACK had time to go out (see
+// BleManager::rebootDue), after the queued log lines are written.
 class AdminListener : public BleListner {
+  // Time the radio gets to send the ACK before the reboot
+  static constexpr unsigned long REBOOT_DELAY_MS = 500;
+
   Logger *_logger = nullptr;
-  AdminSettings *_settings = nullptr;
-  AdminProtocol *_protocol = nullptr;
-  void onReceive(std::string value) override;
+  AdminSettings _settings;
+  AdminProtocol _protocol;
+  // Written before _rebootRequested is set, read after it is seen
+  unsigned long _rebootRequestedAt = 0;
+  std::atomic<bool> _rebootRequested{false};
+  void onReceive(std::string_view command) override;
 
 public:
   AdminListener(Settings *settings, Logger *logger)
-      : _settings(new AdminSettings(settings)), _protocol(new AdminProtocol(_settings)), _logger(logger) {
+      : _logger(logger), _settings(settings), _protocol(&_settings) {
     this->name = "Admin Channel";
     this->channelId = "0001";
   }
+
+  // True once a reboot was requested and REBOOT_DELAY_MS went by
+  bool rebootDue(unsigned long nowMs) const;
 };
\ No newline at end of file
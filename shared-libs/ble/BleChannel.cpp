@@ -1,21 +1,24 @@
 #include "BleChannel.h"
 #include "BleUuid.h"
+#include <cstring>
 
 BleChannel::BleChannel(NimBLEService *service, BleConnectionListner *connectionListner, BleListner *listner,
-                       const char *serviceId, Logger *logger) {
-  logger->info("Creating BLE Channel: %s", listner->name);
+                       BleInbox *inbox, const char *serviceId, Logger *logger) {
+  LOG_INFO(logger, "Creating BLE Channel: %s", listner->name);
   _connectionListner = connectionListner;
   _listner = listner;
+  _inbox = inbox;
   _logger = logger;
 
   std::string txUuid = buildTxUuid(serviceId, listner->channelId);
   std::string rxUuid = buildRxUuid(serviceId, listner->channelId);
 
-  logger->debug("Creating TX Port: %s", txUuid.c_str());
+  LOG_DEBUG(logger, "Creating TX Port: %s", txUuid.c_str());
   _txPort = service->createCharacteristic(txUuid.c_str(), NIMBLE_PROPERTY::READ_AUTHEN | NIMBLE_PROPERTY::NOTIFY);
   _txPort->createDescriptor(HUMAN_READABLE_NAME, NIMBLE_PROPERTY::READ)->setValue(std::string(listner->name) + " (TX)");
+  _txPort->setCallbacks(this);
 
-  logger->debug("Creating RX Port: %s", rxUuid.c_str());
+  LOG_DEBUG(logger, "Creating RX Port: %s", rxUuid.c_str());
   NimBLECharacteristic *rxChannel =
       service->createCharacteristic(rxUuid.c_str(), NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_AUTHEN);
   rxChannel->createDescriptor(HUMAN_READABLE_NAME, NIMBLE_PROPERTY::READ)
@@ -23,36 +26,68 @@ BleChannel::BleChannel(NimBLEService *service, BleConnectionListner *connectionL
   rxChannel->setCallbacks(this);
 
   _listner->onChannelAttach(this);
-  logger->debug("BLE Channel %s created", listner->name);
+  LOG_DEBUG(logger, "BLE Channel %s created", listner->name);
 }
 
-void BleChannel::sendData(const std::string &data) {
+// Disconnected: nothing is staged, the sender step drops what is queued
+bool BleChannel::sendData(const char *data, size_t length, OutboundQueue::Policy policy) {
   if (!_connectionListner->isConnected()) {
-    return;
+    return false;
   }
 
-  // Append end-of-message marker for mobile app to reassemble chunks
-  std::string dataWithMarker = data + "\n";
-
-  // In standard BLE, we avoid sending more than 20 bytes per packet
-  // to ensure it works on all phones (Android/iOS) without negotiating the MTU.
-  size_t chunkSize = 20;
-  for (size_t i = 0; i < dataWithMarker.length(); i += chunkSize) {
-    std::string chunck = dataWithMarker.substr(i, std::min(dataWithMarker.length() - i, chunkSize));
-    _txPort->setValue((uint8_t *)chunck.c_str(), chunck.length());
-    _txPort->notify();
-
-    // Critical pause
-    // This allows the Bluetooth stack to process the send
-    // Without this, you will lose packets
-    delay(10);
+  return send(data, length, policy);
+}
+
+bool BleChannel::sendFrameData(const uint8_t *frame, size_t length, OutboundQueue::Policy policy) {
+  if (!_connectionListner->isConnected()) {
+    return false;
+  }
+
+  return sendFrame(frame, length, policy);
+}
+
+void BleChannel::reportTruncated(size_t capacity) {
+  LOG_WARN(_logger, "%s: message longer than %u bytes dropped", _listner->name, static_cast<unsigned>(capacity));
+}
+
+bool BleChannel::transmit(const uint8_t *data, size_t length) {
+  // notify() reports a refused notification through onStatus() before returning
+  _notifyRefused = false;
+  _txPort->setValue(data, length);
+  _txPort->notify();
+  return !_notifyRefused;
+}
+
+void BleChannel::onStatus(NimBLECharacteristic *channel, Status status, int code) {
+  // Out of buffers: the stack is congested, the chunk is retried by the next flush
+  if (status == ERROR_GATT && code == BLE_HS_ENOMEM) {
+    _notifyRefused = true;
+  }
+}
+
+void BleChannel::onSubscribe(NimBLECharacteristic *channel, ble_gap_conn_desc *desc, uint16_t subValue) {
+  if (subValue != 0) {
+    post(BleEvent::SUBSCRIBE, std::string_view());
   }
 }
 
 void BleChannel::onWrite(NimBLECharacteristic *channel) {
   std::string rxValue = channel->getValue();
   if (rxValue.length() > 0) {
-    _logger->debug("\nReceived from phone: %s", rxValue);
-    _listner->onReceive(rxValue);
+    LOG_DEBUG(_logger, "\nReceived from phone: %s", rxValue.c_str());
+    post(BleEvent::RECEIVE, rxValue);
+  }
+}
+
+void BleChannel::post(BleEvent::Kind kind, std::string_view command) {
+  BleEvent *event = command.length() <= BleEvent::MAX_COMMAND_SIZE ? _inbox->claim() : nullptr;
+  if (event == nullptr) {
+    LOG_WARN(_logger, "%s: event dropped (%u bytes)", _listner->name, static_cast<unsigned>(command.length()));
+    return;
   }
+  event->listner = _listner;
+  event->kind = kind;
+  event->length = command.length();
+  memcpy(event->command, command.data(), command.length());
+  _inbox->publish();
 }
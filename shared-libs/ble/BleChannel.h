@@ -2,20 +2,55 @@
 
 #include "BleConnectionListner.h"
 #include "BleListner.h"
+#include "ChunkedSender.h"
 #include "Logger.h"
+#include "SpscQueue.h"
 #include <NimBLEDevice.h>
+#include <stddef.h>
 
-class BleChannel : public NimBLECharacteristicCallbacks {
+// A write or a subscription, handed by the NimBLE host task to the control task where
+// the listener runs (BleManager::dispatch): protocols never race the control loops
+struct BleEvent {
+  enum Kind { RECEIVE, SUBSCRIBE };
+  // Longest command kept, a longer write is dropped
+  static constexpr size_t MAX_COMMAND_SIZE = 128;
+
+  BleListner *listner;
+  Kind kind;
+  size_t length;
+  char command[MAX_COMMAND_SIZE];
+};
+
+// Every NimBLE callback runs on the host task, the single producer
+using BleInbox = SpscQueue<BleEvent, 8>;
+static_assert(BleInbox::CAPACITY <= ChunkedSender::REPLY_RESERVE, "Every command of a full inbox must get its reply");
+
+class BleChannel : public NimBLECharacteristicCallbacks, public ChunkedSender {
   const char *HUMAN_READABLE_NAME = "2901";
   NimBLECharacteristic *_txPort = nullptr;
   BleConnectionListner *_connectionListner = nullptr;
   BleListner *_listner = nullptr;
+  BleInbox *_inbox = nullptr;
   Logger *_logger = nullptr;
+  bool _notifyRefused = false;
 
   void onWrite(NimBLECharacteristic *channel) override;
+  void onStatus(NimBLECharacteristic *channel, Status status, int code) override;
+  void onSubscribe(NimBLECharacteristic *channel, ble_gap_conn_desc *desc, uint16_t subValue) override;
+  // Queues the event for the control task, dropped (and logged) when the inbox is full
+  void post(BleEvent::Kind kind, std::string_view command);
+
+protected:
+  bool transmit(const uint8_t *data, size_t length) override;
 
 public:
-  BleChannel(NimBLEService *service, BleConnectionListner *connectionListner, BleListner *listner,
+  BleChannel(NimBLEService *service, BleConnectionListner *connectionListner, BleListner *listner, BleInbox *inbox,
              const char *serviceId, Logger *logger);
-  void sendData(const std::string &data);
+  // Stages the message for the sender step (BleManager::loop), false when refused or
+  // disconnected. Control task only.
+  bool sendData(const char *data, size_t length, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP);
+  // Same for a binary frame, sent alone in one notification
+  bool sendFrameData(const uint8_t *frame, size_t length, OutboundQueue::Policy policy);
+  // Logs a message dropped because its writer ran out of room
+  void reportTruncated(size_t capacity);
 };
\ No newline at end of file
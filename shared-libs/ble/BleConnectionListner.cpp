@@ -2,23 +2,31 @@
 
 bool BleConnectionListner::isConnected() { return _deviceConnected; }
 
+uint16_t BleConnectionListner::getMtu() { return _mtu; }
+
 void BleConnectionListner::onConnect(NimBLEServer *server) {
   _deviceConnected = true;
   if (_logger) {
-    _logger->info("BLE Client Connected");
+    LOG_INFO(_logger, "BLE Client Connected");
   }
 };
 
 void BleConnectionListner::onDisconnect(NimBLEServer *server) {
   _deviceConnected = false;
+  _mtu = BLE_ATT_MTU_DFLT;
   if (_logger) {
-    _logger->info("BLE Client Disconnected");
+    LOG_INFO(_logger, "BLE Client Disconnected");
   }
   NimBLEDevice::startAdvertising();
 };
 
 void BleConnectionListner::onAuthenticationComplete(ble_gap_conn_desc *desc) {
   if (desc->sec_state.encrypted) {
-    _logger->info("Success: Secure connection established!");
+    LOG_INFO(_logger, "Success: Secure connection established!");
   }
 }
+
+void BleConnectionListner::onMTUChange(uint16_t mtu, ble_gap_conn_desc *desc) {
+  _mtu = mtu;
+  LOG_DEBUG(_logger, "BLE MTU negotiated: %d", mtu);
+}
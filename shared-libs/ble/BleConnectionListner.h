@@ -2,15 +2,21 @@
 
 #include "Logger.h"
 #include <NimBLEDevice.h>
+#include <atomic>
 
 class BleConnectionListner : public NimBLEServerCallbacks {
   void onConnect(NimBLEServer *server) override;
   void onDisconnect(NimBLEServer *server) override;
   void onAuthenticationComplete(ble_gap_conn_desc *desc) override;
+  void onMTUChange(uint16_t mtu, ble_gap_conn_desc *desc) override;
   Logger *_logger;
-  bool _deviceConnected = false;
+  // Written by the NimBLE host task, read by the control and radio tasks
+  std::atomic<bool> _deviceConnected{false};
+  std::atomic<uint16_t> _mtu{BLE_ATT_MTU_DFLT};
 
 public:
   BleConnectionListner(Logger *logger) : _logger(logger) {}
   bool isConnected();
+  // ATT MTU negotiated with the connected peer (23 until it asks for more)
+  uint16_t getMtu();
 };
\ No newline at end of file
@@ -3,9 +3,21 @@
 
 void BleListner::onChannelAttach(BleChannel *channel) { _channel = channel; }
 
-bool BleListner::send(const std::string &data) {
+bool BleListner::send(const char *data, size_t length, OutboundQueue::Policy policy) {
   if (_channel == nullptr)
     return false;
-  _channel->sendData(data);
-  return true;
+  return _channel->sendData(data, length, policy);
+}
+
+bool BleListner::dropTruncated(size_t capacity) {
+  if (_channel != nullptr) {
+    _channel->reportTruncated(capacity);
+  }
+  return false;
+}
+
+bool BleListner::sendFrame(const uint8_t *frame, size_t length, OutboundQueue::Policy policy) {
+  if (_channel == nullptr)
+    return false;
+  return _channel->sendFrameData(frame, length, policy);
 }
@@ -1,6 +1,15 @@
 #pragma once
 
+#include "CommandTable.h"
+#include "FixedWriter.h"
+#include "OutboundQueue.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+
+static_assert(CommandReply::CAPACITY <= OutboundQueue::MAX_MESSAGE_SIZE, "A reply must fit one outbound message");
 
 class BleChannel;
 
@@ -13,6 +22,28 @@ public:
   const char *channelId;
 
   void onChannelAttach(BleChannel *channel);
-  bool send(const std::string &data);
-  virtual void onReceive(std::string value) = 0;
+  // Telemetry superseded by the next notification should be sent with DROP_OLDEST
+  bool send(const char *data, size_t length, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP);
+  bool send(const std::string &data, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP) {
+    return send(data.data(), data.length(), policy);
+  }
+  bool send(const char *data, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP) {
+    return send(data, strlen(data), policy);
+  }
+  // A message its writer cut is malformed: dropped and logged, never sent in part
+  template <size_t N>
+  bool send(const FixedWriter<N> &message, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP) {
+    if (message.overflowed()) {
+      return dropTruncated(N);
+    }
+    return send(message.data(), message.size(), policy);
+  }
+  bool sendFrame(const uint8_t *frame, size_t length, OutboundQueue::Policy policy);
+  // command views the inbox slot (see BleManager::dispatch): valid until return only
+  virtual void onReceive(std::string_view command) = 0;
+  // The peer subscribed to this channel's notifications
+  virtual void onSubscribe() {}
+
+private:
+  bool dropTruncated(size_t capacity);
 };
\ No newline at end of file
@@ -6,7 +6,7 @@
 #include <Arduino.h>
 
 void BleManager::setup(std::string defaultName, std::string serviceId) {
-  _logger->info("Setup BLE...");
+  LOG_INFO(_logger, "Setup BLE...");
   _serviceId = serviceId;
   _serviceUuid = buildServiceUuid(serviceId.c_str());
   AdminSettings adminSettings(_settings);
@@ -33,27 +33,60 @@ void BleManager::setup(std::string defaultName, std::string serviceId) {
   NimBLEDevice::setSecurityIOCap(BLE_HS_IO_DISPLAY_ONLY);
 
   NimBLEServer *server = NimBLEDevice::createServer();
-  _connectionListner = new BleConnectionListner(_logger);
-  server->setCallbacks(_connectionListner);
+  server->setCallbacks(&_connectionListner);
 
   _service = server->createService(_serviceUuid.c_str());
-  _adminChannel =
-      new BleChannel(_service, _connectionListner, new AdminListener(_settings, _logger), _serviceId.c_str(), _logger);
-  _logger->info("BLE setup complete, advertising as %s", deviceName.c_str());
+  addChannel(&_adminListner);
+  LOG_INFO(_logger, "BLE setup complete, advertising as %s", deviceName.c_str());
 }
 
 void BleManager::start() {
-  _logger->info("Starting BLE service...");
+  LOG_INFO(_logger, "Starting BLE service...");
   _service->start();
 
-  _logger->debug("Starting advertising...");
+  LOG_DEBUG(_logger, "Starting advertising...");
   NimBLEAdvertising *advertising = NimBLEDevice::getAdvertising();
   advertising->addServiceUUID(_serviceUuid.c_str());
   advertising->start();
 }
 
 BleChannel *BleManager::addChannel(BleListner *listner) {
-  return new BleChannel(_service, _connectionListner, listner, _serviceId.c_str(), _logger);
+  if (_channelCount == MAX_CHANNELS) {
+    LOG_WARN(_logger, "No channel left for %s (MAX_CHANNELS %u)", listner->name, static_cast<unsigned>(MAX_CHANNELS));
+    return nullptr;
+  }
+  return &_channels[_channelCount++].emplace(_service, &_connectionListner, listner, &_inbox, _serviceId.c_str(),
+                                             _logger);
 }
 
-bool BleManager::isConnected() { return _connectionListner->isConnected(); }
\ No newline at end of file
+void BleManager::dispatch() {
+  for (BleEvent *event = _inbox.front(); event != nullptr; event = _inbox.front()) {
+    if (event->kind == BleEvent::SUBSCRIBE) {
+      event->listner->onSubscribe();
+    } else {
+      event->listner->onReceive(std::string_view(event->command, event->length));
+    }
+    _inbox.pop();
+  }
+}
+
+void BleManager::loop() {
+  const bool connected = isConnected();
+  const uint16_t mtu = _connectionListner.getMtu();
+  for (size_t i = 0; i < _channelCount; i++) {
+    if (connected) {
+      _channels[i]->setMtu(mtu);
+      _channels[i]->flush();
+    } else {
+      _channels[i]->clear();
+    }
+  }
+}
+
+bool BleManager::isConnected() { return _connectionListner.isConnected(); }
+bool BleManager::rebootDue() const { return _adminListner.rebootDue(millis()); }
+
+void BleManager::reboot() {
+  NimBLEDevice::deleteAllBonds();
+  ESP.restart();
+}
@@ -1,25 +1,50 @@
 #pragma once
 
+#include "AdminListner.h"
 #include "BleChannel.h"
+#include "BleConnectionListner.h"
+#include "Deferred.h"
 #include "Logger.h"
 #include "Settings.h"
 #include <NimBLEDevice.h>
+#include <stddef.h>
 #include <string>
 
 class BleManager {
+public:
+  // Admin channel included; the heater module uses 7
+  static constexpr size_t MAX_CHANNELS = 8;
+
 private:
   std::string _serviceId;
   std::string _serviceUuid;
   Logger *_logger = nullptr;
   Settings *_settings = nullptr;
-  BleChannel *_adminChannel = nullptr;
   NimBLEService *_service = nullptr;
-  BleConnectionListner *_connectionListner = nullptr;
+  BleConnectionListner _connectionListner;
+  AdminListener _adminListner;
+  // Writes and subscriptions of every channel, waiting for dispatch()
+  BleInbox _inbox;
+  // The channels need the service, created by setup(): built in place then
+  Deferred<BleChannel> _channels[MAX_CHANNELS];
+  size_t _channelCount = 0;
 
 public:
-  BleManager(Logger *logger, Settings *settings) : _logger(logger), _settings(settings) {}
+  BleManager(Logger *logger, Settings *settings)
+      : _logger(logger), _settings(settings), _connectionListner(logger), _adminListner(settings, logger) {}
   void setup(std::string defaultName, std::string serviceId);
+  // Null (and logged) when the MAX_CHANNELS channels are taken
   BleChannel *addChannel(BleListner *listner);
   void start();
+  // Runs the listeners on the received commands and subscriptions. Control task only.
+  void dispatch();
+  // Sender step: sends what every channel queued (drops it once disconnected). Radio task only.
+  void loop();
   bool isConnected();
+  // An admin command saved settings that apply at boot, and its ACK had time to go out.
+  // Radio task only, like reboot().
+  bool rebootDue() const;
+  // Deletes the bonds (mandatory: the client must pair again with the new PIN) then
+  // restarts. Flush the logger first.
+  void reboot();
 };
@@ -0,0 +1,16 @@
+#include "TelemetryListner.h"
+#include <Arduino.h>
+
+TelemetryListner::TelemetryListner(const char *name, Settings *settings, size_t measuredFields)
+    : _gate(measuredFields), _telemetrySettings(settings, name), _telemetryProtocol(&_telemetrySettings, &_gate) {
+  _telemetryProtocol.begin();
+}
+
+void TelemetryListner::onSubscribe() {
+  _telemetryProtocol.resetFormat();
+  forcePublish();
+}
+
+bool TelemetryListner::shouldPublish(const int *values, size_t count) {
+  return _gate.shouldPublish(values, count, millis());
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "BleListner.h"
+#include "Settings.h"
+#include "TelemetryFrame.h"
+#include "TelemetryGate.h"
+#include "TelemetryProtocol.h"
+#include "TelemetrySettings.h"
+#include <string_view>
+
+// Listener of a channel publishing telemetry only when it changed (see TelemetryGate).
+// The thresholds are persisted under the channel name and set with the TLM commands
+// (see TelemetryProtocol). A new subscriber always gets the next frame, in ASCII until
+// it selects binary frames with FMT:BIN.
+class TelemetryListner : public BleListner {
+  TelemetryGate _gate;
+  TelemetrySettings _telemetrySettings;
+  TelemetryProtocol _telemetryProtocol;
+  uint8_t _sequence = 0;
+
+protected:
+  TelemetryListner(const char *name, Settings *settings, size_t measuredFields);
+
+  // Writes the response to a TLM, CAP or FMT command, nothing when command is not one
+  void handleTelemetry(std::string_view command, CommandReply &reply) { _telemetryProtocol.handle(command, reply); }
+  // True when the frame must be sent, see TelemetryGate
+  bool shouldPublish(const int *values, size_t count);
+  void forcePublish() { _gate.invalidate(); }
+  bool binaryFrames() const { return _telemetryProtocol.getFormat() == TelemetryProtocol::BINARY; }
+
+  // Sends the payload as a binary frame (see TelemetryFrame), numbered per channel
+  template <typename Payload> bool publishFrame(const Payload &payload) {
+    uint8_t frame[TelemetryFrame::MAX_SIZE];
+    const size_t length = TelemetryFrame::encode(payload, _sequence++, frame);
+    return sendFrame(frame, length, OutboundQueue::DROP_OLDEST);
+  }
+
+public:
+  void onSubscribe() override;
+};
@@ -1,27 +1,51 @@
 #include "Esp32Settings.h"
 
+// Opened lazily: the settings object is built during static initialisation,
+// before the Arduino core has initialised the NVS partition.
+bool Esp32Settings::open() {
+  if (!_open) {
+    _open = nvs_open(_nameSpace, NVS_READWRITE, &_handle) == ESP_OK;
+  }
+  return _open;
+}
+
 int Esp32Settings::get(const char *key, const int defaultValue) {
-  prefs.begin(_nameSpace, false);
-  int result = prefs.getInt(key, defaultValue);
-  prefs.end();
-  return result;
+  int32_t value = 0;
+  if (!open() || nvs_get_i32(_handle, key, &value) != ESP_OK) {
+    return defaultValue;
+  }
+  return value;
 }
 
 void Esp32Settings::save(const char *key, const int value) {
-  prefs.begin(_nameSpace, false);
-  prefs.putInt(key, value);
-  prefs.end();
+  if (open()) {
+    nvs_set_i32(_handle, key, value);
+  }
 }
 
 std::string Esp32Settings::get(const char *key, const std::string defaultValue) {
-  prefs.begin(_nameSpace, false);
-  String result = prefs.getString(key, defaultValue.c_str());
-  prefs.end();
-  return std::string(result.c_str());
+  size_t length = 0;
+  if (!open() || nvs_get_str(_handle, key, nullptr, &length) != ESP_OK || length == 0) {
+    return defaultValue;
+  }
+
+  // length counts the terminating NUL
+  std::string value(length, '\0');
+  if (nvs_get_str(_handle, key, &value[0], &length) != ESP_OK) {
+    return defaultValue;
+  }
+  value.resize(length - 1);
+  return value;
 }
 
 void Esp32Settings::save(const char *key, const char *value) {
-  prefs.begin(_nameSpace, false);
-  prefs.putString(key, value);
-  prefs.end();
+  if (open()) {
+    nvs_set_str(_handle, key, value);
+  }
+}
+
+void Esp32Settings::flush() {
+  if (open()) {
+    nvs_commit(_handle);
+  }
 }
@@ -2,17 +2,24 @@
 
 #include "Settings.h"
 #include <Arduino.h>
-#include <Preferences.h>
+#include <nvs.h>
 #include <string>
 
+// NVS-backed settings (same storage format as the Arduino Preferences library).
+// The namespace is opened on first access and kept open. Saves are staged in NVS
+// and only committed by flush().
 class Esp32Settings : public Settings {
   const char *_nameSpace;
-  Preferences prefs;
+  nvs_handle_t _handle = 0;
+  bool _open = false;
+
+  bool open();
 
 public:
   Esp32Settings(const char *nameSpace) : _nameSpace(nameSpace) {}
-  int get(const char *key, const int defaultValue);
-  void save(const char *key, const int value);
-  std::string get(const char *key, const std::string defaultValue);
-  void save(const char *key, const char *value);
-};
\ No newline at end of file
+  int get(const char *key, const int defaultValue) override;
+  void save(const char *key, const int value) override;
+  std::string get(const char *key, const std::string defaultValue) override;
+  void save(const char *key, const char *value) override;
+  void flush() override;
+};
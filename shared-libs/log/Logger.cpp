@@ -1,43 +1,245 @@
 #include "Logger.h"
+#include <stdio.h>
+#include <string.h>
 
-Logger::Logger(Stream &stream, Level lvl) : out(&stream), level(lvl), maxLogMsgSize(256) {}
+constexpr const char *Logger::TAGS[];
+
+static_assert((Logger::QUEUE_SIZE & (Logger::QUEUE_SIZE - 1)) == 0, "QUEUE_SIZE must be a power of two");
+
+Logger::Logger(Stream &stream, Level lvl) : out(&stream), level(lvl) {
+  for (size_t i = 0; i < QUEUE_SIZE; i++) {
+    _records[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
 
 void Logger::setLevel(Level lvl) { level = lvl; }
 
-void Logger::debug(const char *fmt, ...) {
-  if (level > DEBUG)
-    return;
-  va_list ap;
-  va_start(ap, fmt);
-  log("DEBUG", fmt, ap);
-  va_end(ap);
-}
-
-void Logger::info(const char *fmt, ...) {
-  if (level > INFO)
-    return;
-  va_list ap;
-  va_start(ap, fmt);
-  log("INFO", fmt, ap);
-  va_end(ap);
-}
-
-void Logger::warn(const char *fmt, ...) {
-  if (level > INFO)
-    return;
-  va_list ap;
-  va_start(ap, fmt);
-  log("WARN", fmt, ap);
-  va_end(ap);
-}
-
-void Logger::flush() { out->flush(); }
-
-void Logger::log(const char *tag, const char *fmt, va_list ap) {
-  char buf[Logger::maxLogMsgSize];
-  vsnprintf(buf, sizeof(buf), fmt, ap);
-  out->write((const uint8_t *)"\n[", 2);
-  out->write((const uint8_t *)tag, strlen(tag));
-  out->write((const uint8_t *)"] ", 2);
-  out->write((const uint8_t *)buf, strlen(buf));
+Logger::Record *Logger::reserve() {
+  size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+  for (;;) {
+    Record &record = _records[pos & (QUEUE_SIZE - 1)];
+    const size_t sequence = record.sequence.load(std::memory_order_acquire);
+    const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      // Free slot: claim it, or retry from the position another producer left
+      if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        return &record;
+      }
+    } else if (diff < 0) {
+      // Still holding the line from one lap ago: the ring is full. The drop is reported
+      // once the lines reserved before it are written.
+      size_t droppedAt = _droppedAt.load(std::memory_order_relaxed);
+      while (static_cast<intptr_t>(pos - droppedAt) > 0 &&
+             !_droppedAt.compare_exchange_weak(droppedAt, pos, std::memory_order_relaxed)) {
+      }
+      _dropped.fetch_add(1, std::memory_order_release);
+      return nullptr;
+    } else {
+      pos = _enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void Logger::publish(Record *record) {
+  const size_t sequence = record->sequence.load(std::memory_order_relaxed);
+  record->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+void Logger::store(Record &record, int index, const char *value) {
+  record.kinds[index] = TEXT;
+  record.values[index].textOffset = record.textLength;
+  if (value == nullptr) {
+    value = "(null)";
+  }
+  // Always room for the terminator: a text past the buffer is cut, later ones are empty
+  size_t length = record.textLength;
+  while (*value != '\0' && length < TEXT_SIZE - 1) {
+    record.text[length++] = *value++;
+  }
+  record.text[length] = '\0';
+  record.textLength = static_cast<uint8_t>(length < TEXT_SIZE - 1 ? length + 1 : length);
+}
+
+void Logger::drain() {
+  const int room = out->availableForWrite();
+  if (room > 0) {
+    drain(static_cast<size_t>(room));
+  }
+}
+
+void Logger::drain(size_t maxBytes) {
+  while (maxBytes > 0) {
+    if (_lineWritten == _lineLength) {
+      if (!formatNext()) {
+        return;
+      }
+    }
+    size_t count = _lineLength - _lineWritten;
+    if (count > maxBytes) {
+      count = maxBytes;
+    }
+    out->write(reinterpret_cast<const uint8_t *>(_line + _lineWritten), count);
+    _lineWritten += count;
+    maxBytes -= count;
+  }
+}
+
+void Logger::flush() {
+  drain(SIZE_MAX);
+  out->flush();
+}
+
+bool Logger::formatNext() {
+  _lineWritten = 0;
+  _lineLength = 0;
+
+  const uint32_t dropped = _dropped.load(std::memory_order_acquire);
+  const size_t droppedAt = _droppedAt.load(std::memory_order_relaxed);
+  if (dropped != _reportedDropped && static_cast<intptr_t>(_dequeuePos - droppedAt) >= 0) {
+    const int length = snprintf(_line, sizeof(_line), "\n[WARN] %lu log lines dropped",
+                                static_cast<unsigned long>(dropped - _reportedDropped));
+    _reportedDropped = dropped;
+    _lineLength = length > 0 ? static_cast<size_t>(length) : 0;
+    return true;
+  }
+
+  Record &record = _records[_dequeuePos & (QUEUE_SIZE - 1)];
+  if (record.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) {
+    return false;
+  }
+  _lineLength = render(record, _line, sizeof(_line));
+  // Hand the slot back to the producers, one lap ahead
+  record.sequence.store(_dequeuePos + QUEUE_SIZE, std::memory_order_release);
+  _dequeuePos++;
+  return true;
+}
+
+long long Logger::toInteger(Kind kind, const Value &value) {
+  switch (kind) {
+  case UNSIGNED:
+    return static_cast<long long>(value.u);
+  case REAL:
+    return static_cast<long long>(value.d);
+  case SIGNED:
+    return value.i;
+  default:
+    return 0;
+  }
+}
+
+size_t Logger::render(const Record &record, char *buf, size_t size) const {
+  int written = snprintf(buf, size, "\n[%s] ", record.tag);
+  size_t pos = written > 0 ? static_cast<size_t>(written) : 0;
+  int argIndex = 0;
+
+  for (const char *p = record.fmt; *p != '\0' && pos < size - 1;) {
+    if (*p != '%') {
+      buf[pos++] = *p++;
+      continue;
+    }
+    if (p[1] == '%') {
+      buf[pos++] = '%';
+      p += 2;
+      continue;
+    }
+
+    // One conversion: %[flags][width][.precision][length]type
+    const char *start = p++;
+    while (*p != '\0' && strchr("-+ #0123456789.", *p) != nullptr) {
+      p++;
+    }
+    const char *lengthStart = p;
+    while (*p != '\0' && strchr("hlLqjzt", *p) != nullptr) {
+      p++;
+    }
+    const char conversion = *p;
+    if (conversion == '\0') {
+      break;
+    }
+    p++;
+
+    char spec[24];
+    const size_t specLength = static_cast<size_t>(p - start);
+    if (specLength >= sizeof(spec) || argIndex >= record.argCount) {
+      // Malformed, or more conversions than arguments: printed as is
+      for (const char *c = start; c < p && pos < size - 1; c++) {
+        buf[pos++] = *c;
+      }
+      continue;
+    }
+    memcpy(spec, start, specLength);
+    spec[specLength] = '\0';
+
+    const int index = argIndex++;
+    const Kind kind = record.kinds[index];
+    const Value &value = record.values[index];
+    const bool isLong = lengthStart[0] == 'l' && lengthStart[1] != 'l';
+    const bool isLongLong = (lengthStart[0] == 'l' && lengthStart[1] == 'l') || lengthStart[0] == 'q' ||
+                            lengthStart[0] == 'j';
+    const bool isSize = lengthStart[0] == 'z' || lengthStart[0] == 't';
+    const long long integer = toInteger(kind, value);
+    char *dest = buf + pos;
+    const size_t room = size - pos;
+
+    // Cast the stored value to the exact type the conversion expects
+    switch (conversion) {
+    case 'd':
+    case 'i':
+      if (isLongLong) {
+        written = snprintf(dest, room, spec, integer);
+      } else if (isLong) {
+        written = snprintf(dest, room, spec, static_cast<long>(integer));
+      } else if (isSize) {
+        written = snprintf(dest, room, spec, static_cast<ptrdiff_t>(integer));
+      } else {
+        written = snprintf(dest, room, spec, static_cast<int>(integer));
+      }
+      break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+      if (isLongLong) {
+        written = snprintf(dest, room, spec, static_cast<unsigned long long>(integer));
+      } else if (isLong) {
+        written = snprintf(dest, room, spec, static_cast<unsigned long>(integer));
+      } else if (isSize) {
+        written = snprintf(dest, room, spec, static_cast<size_t>(integer));
+      } else {
+        written = snprintf(dest, room, spec, static_cast<unsigned int>(integer));
+      }
+      break;
+    case 'c':
+      written = snprintf(dest, room, spec, static_cast<int>(integer));
+      break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+      if (lengthStart[0] == 'L') {
+        // Stored as double: drop the long double modifier
+        memmove(spec + (lengthStart - start), spec + (lengthStart - start) + 1, specLength - (lengthStart - start));
+      }
+      written = snprintf(dest, room, spec, kind == REAL ? value.d : static_cast<double>(integer));
+      break;
+    case 's':
+      written = snprintf(dest, room, spec, kind == TEXT ? record.text + value.textOffset : "");
+      break;
+    case 'p':
+      written = snprintf(dest, room, spec, kind == POINTER ? value.p : nullptr);
+      break;
+    default:
+      written = snprintf(dest, room, "%s", spec);
+      break;
+    }
+    if (written > 0) {
+      pos += static_cast<size_t>(written) < room ? static_cast<size_t>(written) : room - 1;
+    }
+  }
+  buf[pos] = '\0';
+  return pos;
 }
@@ -1,25 +1,165 @@
 #pragma once
 #include <Arduino.h>
-#include <stdarg.h>
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
 
+// Lowest level compiled in (0 DEBUG, 1 INFO, 2 WARN), set from the build flags. A LOG_*
+// statement below it is removed, arguments included: nothing is evaluated or queued.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+// Preferred over the methods: the level test is a constant, the call and its arguments
+// disappear when the level is compiled out. The runtime level still filters the rest.
+#define LOG_AT(level, logger, ...)                                                                                   \
+  do {                                                                                                                 \
+    if ((level) >= LOG_MIN_LEVEL) {                                                                                    \
+      (logger)->log(level, __VA_ARGS__);                                                                               \
+    }                                                                                                                  \
+  } while (0)
+#define LOG_DEBUG(logger, ...) LOG_AT(Logger::DEBUG, logger, __VA_ARGS__)
+#define LOG_INFO(logger, ...) LOG_AT(Logger::INFO, logger, __VA_ARGS__)
+#define LOG_WARN(logger, ...) LOG_AT(Logger::WARN, logger, __VA_ARGS__)
+
+// Deferred logger: debug()/info()/warn() only copy the format pointer and the raw
+// arguments into a lock-free ring of records, safe from several tasks at once. Formatting
+// and the serial writes happen in drain(), called from the service step, so a log line
+// never blocks its caller on a 9600-baud UART.
+// The format must be a string literal (only its pointer is kept). %s arguments are copied,
+// up to TEXT_SIZE bytes per line. '*' widths are not supported. A full ring drops the
+// line and counts it; drain() reports the drops in a WARN line, after the lines queued
+// before them.
 class Logger {
 public:
-  enum Level { DEBUG = 0, INFO = 1 };
+  enum Level { DEBUG = 0, INFO = 1, WARN = 2 };
+
+  // Records in the ring, a power of two. Covers the setup burst of the modules.
+  static constexpr size_t QUEUE_SIZE = 32;
+  static constexpr int MAX_ARGS = 10;
+  static constexpr size_t TEXT_SIZE = 32;
+  static constexpr size_t MAX_LINE_SIZE = 256;
 
   // construct with a Stream (e.g. Serial)
   Logger(Stream &stream, Level lvl = INFO);
 
   void setLevel(Level lvl);
 
-  void debug(const char *fmt, ...);
-  void info(const char *fmt, ...);
-  void warn(const char *fmt, ...);
+  template <typename... Args> void log(Level lvl, const char *fmt, Args... args) {
+    if (lvl < level)
+      return;
+    enqueue(TAGS[lvl], fmt, args...);
+  }
+  template <typename... Args> void debug(const char *fmt, Args... args) { log(DEBUG, fmt, args...); }
+  template <typename... Args> void info(const char *fmt, Args... args) { log(INFO, fmt, args...); }
+  template <typename... Args> void warn(const char *fmt, Args... args) { log(WARN, fmt, args...); }
+
+  // Formats and writes the queued lines, at most maxBytes of output, a line cut by the
+  // budget resuming on the next call. Consumer side: call it from one task only.
+  void drain(size_t maxBytes);
+  // Writes what the stream accepts without blocking (its availableForWrite())
+  void drain();
+  // Writes every queued line, then flushes the stream (before sleeping)
   void flush();
 
+  // Lines lost to a full ring since construction
+  uint32_t getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
 private:
+  enum Kind : uint8_t { SIGNED, UNSIGNED, REAL, TEXT, POINTER };
+
+  union Value {
+    long long i;
+    unsigned long long u;
+    double d;
+    const void *p;
+    size_t textOffset;
+  };
+
+  struct Record {
+    // Vyukov bounded queue: equals the enqueue position when free, position + 1 when filled
+    std::atomic<size_t> sequence;
+    const char *tag;
+    const char *fmt;
+    uint8_t argCount;
+    uint8_t textLength;
+    Kind kinds[MAX_ARGS];
+    Value values[MAX_ARGS];
+    char text[TEXT_SIZE];
+  };
+
+  static constexpr const char *TAGS[] = {"DEBUG", "INFO", "WARN"};
+
   Stream *out;
   Level level;
-  int maxLogMsgSize = 256;
 
-  void log(const char *tag, const char *fmt, va_list ap);
+  Record _records[QUEUE_SIZE];
+  std::atomic<size_t> _enqueuePos{0};
+  size_t _dequeuePos = 0;
+  std::atomic<uint32_t> _dropped{0};
+  // Enqueue position of the latest drop: the lines before it are written first
+  std::atomic<size_t> _droppedAt{0};
+  uint32_t _reportedDropped = 0;
+
+  // Line being written, kept across drain() calls
+  char _line[MAX_LINE_SIZE];
+  size_t _lineLength = 0;
+  size_t _lineWritten = 0;
+
+  Record *reserve();
+  void publish(Record *record);
+  // Formats the next pending line into _line, false when there is none
+  bool formatNext();
+  size_t render(const Record &record, char *buf, size_t size) const;
+  static long long toInteger(Kind kind, const Value &value);
+
+  template <typename... Args> void enqueue(const char *tag, const char *fmt, Args... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "Too many log arguments");
+    Record *record = reserve();
+    if (record == nullptr) {
+      return;
+    }
+    record->tag = tag;
+    record->fmt = fmt;
+    record->argCount = 0;
+    record->textLength = 0;
+    capture(*record, args...);
+    publish(record);
+  }
+
+  static void capture(Record &) {}
+  template <typename T, typename... Rest> static void capture(Record &record, T value, Rest... rest) {
+    store(record, record.argCount++, value);
+    capture(record, rest...);
+  }
+
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type
+  store(Record &record, int index, T value) {
+    record.kinds[index] = SIGNED;
+    record.values[index].i = value;
+  }
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+  store(Record &record, int index, T value) {
+    record.kinds[index] = UNSIGNED;
+    record.values[index].u = value;
+  }
+  template <typename T>
+  static typename std::enable_if<std::is_floating_point<T>::value>::type store(Record &record, int index, T value) {
+    record.kinds[index] = REAL;
+    record.values[index].d = value;
+  }
+  template <typename T>
+  static typename std::enable_if<std::is_enum<T>::value>::type store(Record &record, int index, T value) {
+    record.kinds[index] = SIGNED;
+    record.values[index].i = static_cast<long long>(value);
+  }
+  static void store(Record &record, int index, const char *value);
+  static void store(Record &record, int index, char *value) { store(record, index, static_cast<const char *>(value)); }
+  static void store(Record &record, int index, const void *value) {
+    record.kinds[index] = POINTER;
+    record.values[index].p = value;
+  }
 };
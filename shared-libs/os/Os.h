@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+// The little of the RTOS the modules use, so the task split builds on the host too:
+// FreeRTOS tasks pinned to a core on the ESP32 (OsFreeRtos.cpp), std::thread on the
+// host (OsHost.cpp), where the core and the priority are ignored.
+namespace os {
+
+// Control loops (Arduino loop task) on one core, BLE I/O and logging on the other,
+// next to the NimBLE host task
+enum Core { RADIO_CORE = 0, CONTROL_CORE = 1 };
+
+using TaskFunction = void (*)(void *arg);
+
+// Runs function(arg) on a task of its own, which must never return. False when the
+// task could not be created.
+bool startTask(const char *name, TaskFunction function, void *arg, Core core, size_t stackBytes, unsigned priority);
+// Blocks the calling task, letting the others of its core run
+void sleepMs(unsigned long ms);
+
+} // namespace os
@@ -0,0 +1,17 @@
+#if defined(ESP_PLATFORM)
+#include "Os.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace os {
+
+bool startTask(const char *name, TaskFunction function, void *arg, Core core, size_t stackBytes, unsigned priority) {
+  // ESP-IDF counts the stack depth in bytes
+  return xTaskCreatePinnedToCore(function, name, stackBytes, arg, priority, nullptr, static_cast<BaseType_t>(core)) ==
+         pdPASS;
+}
+
+void sleepMs(unsigned long ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+
+} // namespace os
+#endif
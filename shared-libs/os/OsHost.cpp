@@ -0,0 +1,16 @@
+#if !defined(ESP_PLATFORM)
+#include "Os.h"
+#include <chrono>
+#include <thread>
+
+namespace os {
+
+bool startTask(const char *, TaskFunction function, void *arg, Core, size_t, unsigned) {
+  std::thread(function, arg).detach();
+  return true;
+}
+
+void sleepMs(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+} // namespace os
+#endif
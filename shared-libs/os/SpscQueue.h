@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free FIFO between exactly one producer task and one consumer task, the
+// two sides of a core boundary (see Os.h). Elements are stored in place: nothing
+// allocates. The producer fills the slot claim() returns then publish()es it; the
+// consumer reads front() then pop()s it, so a message is never copied twice.
+// Each index is written by one side only, its release store making the slot it covers
+// visible to the other side. N must be a power of two.
+template <typename T, size_t N> class SpscQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+  static constexpr size_t CAPACITY = N;
+
+  // Producer side: the next free slot, null when the queue is full
+  T *claim() {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) == N) {
+      return nullptr;
+    }
+    return &_slots[tail % N];
+  }
+  // Producer side: hands the claimed slot to the consumer
+  void publish() { _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+  // Producer side: claim() and publish() a copy, false when the queue is full
+  bool push(const T &value) {
+    T *slot = claim();
+    if (slot == nullptr) {
+      return false;
+    }
+    *slot = value;
+    publish();
+    return true;
+  }
+
+  // Consumer side: the oldest element, null when the queue is empty
+  T *front() {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &_slots[head % N];
+  }
+  // Consumer side: frees the front() slot for the producer
+  void pop() { _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  // Exact from either side when the other one is idle, a snapshot otherwise
+  size_t size() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+
+private:
+  T _slots[N];
+  // Free-running positions: tail - head is the element count, wrapping included
+  std::atomic<size_t> _head{0};
+  std::atomic<size_t> _tail{0};
+};
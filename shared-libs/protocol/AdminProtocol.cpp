@@ -1,7 +1,5 @@
 #include "AdminProtocol.h"
 #include "Check.h"
-#include <cstring>
-#include <string>
 
 namespace {
 constexpr const char *ACK_OK = "OK";
@@ -13,12 +11,12 @@ constexpr const char *ERR_NAME_CHARS = "ERR_NAME_CHARS";
 constexpr const char *ERR_ID_FMT = "ERR_ID_FMT";
 
 constexpr size_t PIN_DIGITS = 6;
-constexpr size_t MAX_NAME_LENGTH = 20;
-constexpr const char *NAME_FIELD = "NAME=";
-constexpr const char *PIN_FIELD = ";PIN=";
+constexpr int MAX_PIN = 999999;
+constexpr std::string_view NAME_FIELD = "NAME=";
+constexpr std::string_view PIN_FIELD = ";PIN=";
 
-const char *nameError(const std::string &name) {
-  if (name.size() < 1 || name.size() > MAX_NAME_LENGTH) {
+const char *nameError(std::string_view name) {
+  if (name.size() < 1 || name.size() > AdminSettings::MAX_NAME_LENGTH) {
     return ERR_NAME_LEN;
   }
   if (!isAlphaNumericSentence(name)) {
@@ -27,11 +25,12 @@ const char *nameError(const std::string &name) {
   return nullptr;
 }
 
-const char *pinError(const std::string &pin) {
-  if (pin.size() != PIN_DIGITS) {
+// Parses the six digits (leading zeros included) into pin
+const char *pinError(std::string_view text, int &pin) {
+  if (text.size() != PIN_DIGITS) {
     return ERR_PIN_LEN;
   }
-  if (!isNumeric(pin)) {
+  if (parseInt(text, 0, MAX_PIN, pin) != ParseStatus::OK) {
     return ERR_PIN_NUM;
   }
   return nullptr;
@@ -40,58 +39,64 @@ const char *pinError(const std::string &pin) {
 
 AdminProtocol::AdminProtocol(AdminSettings *settings) : _settings(settings) {}
 
-std::string AdminProtocol::handleIdentity(const std::string &body) {
+constexpr CommandTable<AdminProtocol, 3> AdminProtocol::COMMANDS({
+    {"ID:", &AdminProtocol::writeIdentity},
+    {"PIN:", &AdminProtocol::writePin},
+    {"NAME:", &AdminProtocol::writeName},
+});
+
+void AdminProtocol::handle(std::string_view rx, CommandReply &reply) {
+  static_assert(COMMANDS.isPerfect(), "Two verbs share a hash slot");
+  COMMANDS.dispatch(*this, rx, ERR_UNKNOWN_CMD, reply);
+}
+
+void AdminProtocol::writeIdentity(const CommandArgs &args, CommandReply &reply) {
+  reply.append(storeIdentity(args.body));
+}
+
+void AdminProtocol::writePin(const CommandArgs &args, CommandReply &reply) { reply.append(storePin(args.body)); }
+
+void AdminProtocol::writeName(const CommandArgs &args, CommandReply &reply) { reply.append(storeName(args.body)); }
+
+const char *AdminProtocol::storeIdentity(std::string_view body) {
   if (!startsWith(body, NAME_FIELD)) {
     return ERR_ID_FMT;
   }
 
-  const size_t nameAt = std::strlen(NAME_FIELD);
+  const size_t nameAt = NAME_FIELD.size();
   const size_t pinAt = body.find(PIN_FIELD);
-  if (pinAt == std::string::npos) {
+  if (pinAt == std::string_view::npos) {
     return ERR_ID_FMT;
   }
 
-  const std::string name = body.substr(nameAt, pinAt - nameAt);
-  const std::string pin = body.substr(pinAt + std::strlen(PIN_FIELD));
-
+  const std::string_view name = body.substr(nameAt, pinAt - nameAt);
+  int pin = 0;
   if (const char *error = nameError(name)) {
     return error;
   }
-  if (const char *error = pinError(pin)) {
+  if (const char *error = pinError(body.substr(pinAt + PIN_FIELD.size()), pin)) {
     return error;
   }
 
-  _settings->setDeviceName(name);
-  _settings->setPinCode(std::stoi(pin));
+  _settings->setIdentity(name, pin);
   return ACK_OK;
 }
 
-std::string AdminProtocol::handle(std::string rx) {
-  if (startsWith(rx, "ID:")) {
-    return handleIdentity(rx.substr(3));
-  }
-
-  if (startsWith(rx, "PIN:")) {
-    const std::string newPinStr = rx.substr(4);
-
-    if (const char *error = pinError(newPinStr)) {
-      return error;
-    }
-
-    _settings->setPinCode(std::stoi(newPinStr));
-    return ACK_OK;
+const char *AdminProtocol::storePin(std::string_view body) {
+  int pin = 0;
+  if (const char *error = pinError(body, pin)) {
+    return error;
   }
 
-  if (startsWith(rx, "NAME:")) {
-    const std::string newName = rx.substr(5);
-
-    if (const char *error = nameError(newName)) {
-      return error;
-    }
+  _settings->setPinCode(pin);
+  return ACK_OK;
+}
 
-    _settings->setDeviceName(newName);
-    return ACK_OK;
+const char *AdminProtocol::storeName(std::string_view name) {
+  if (const char *error = nameError(name)) {
+    return error;
   }
 
-  return ERR_UNKNOWN_CMD;
+  _settings->setDeviceName(name);
+  return ACK_OK;
 }
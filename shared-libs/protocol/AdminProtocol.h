@@ -1,7 +1,8 @@
 #pragma once
 
 #include "AdminSettings.h"
-#include <string>
+#include "CommandTable.h"
+#include <string_view>
 
 // RX commands:
 // - "PIN:<6digits>"      -> persists + responds "OK" or "ERR_*"
@@ -13,9 +14,19 @@
 class AdminProtocol {
   AdminSettings *_settings;
 
-  std::string handleIdentity(const std::string &body);
+  static const CommandTable<AdminProtocol, 3> COMMANDS;
+
+  // Free-form bodies, not KEY=VAL integers: validated by the handlers
+  void writeIdentity(const CommandArgs &args, CommandReply &reply);
+  void writePin(const CommandArgs &args, CommandReply &reply);
+  void writeName(const CommandArgs &args, CommandReply &reply);
+  // Validate and persist a body, return the response
+  const char *storeIdentity(std::string_view body);
+  const char *storePin(std::string_view body);
+  const char *storeName(std::string_view name);
 
 public:
   explicit AdminProtocol(AdminSettings *settings);
-  std::string handle(std::string rx);
+  // Writes the response into reply
+  void handle(std::string_view rx, CommandReply &reply);
 };
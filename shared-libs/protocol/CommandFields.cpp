@@ -0,0 +1,17 @@
+#include "CommandFields.h"
+
+std::string_view CommandFields::get(std::string_view key) const {
+  std::string_view rest = _body;
+  while (!rest.empty()) {
+    const size_t end = rest.find(';');
+    const std::string_view field = rest.substr(0, end);
+    if (field.size() > key.size() && field[key.size()] == '=' && field.substr(0, key.size()) == key) {
+      return field.substr(key.size() + 1);
+    }
+    if (end == std::string_view::npos) {
+      break;
+    }
+    rest.remove_prefix(end + 1);
+  }
+  return std::string_view();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Check.h"
+#include <string_view>
+
+// "KEY=VAL;KEY=VAL" body of a command, read in place: every value is a view into the
+// received string, nothing is copied or allocated. Keys match whole, in any order.
+class CommandFields {
+  std::string_view _body;
+
+public:
+  explicit CommandFields(std::string_view body) : _body(body) {}
+
+  // Value of key, empty when the field is missing
+  std::string_view get(std::string_view key) const;
+  // get() then parseInt() within [min, max]; value is only written on OK
+  ParseStatus getInt(std::string_view key, int min, int max, int &value) const {
+    return parseInt(get(key), min, max, value);
+  }
+
+  // The protocol's error code for a failed status (MISSING, NOT_A_NUMBER, OUT_OF_RANGE)
+  static const char *errorFor(ParseStatus status, const char *missing, const char *notANumber,
+                              const char *outOfRange) {
+    return status == ParseStatus::MISSING ? missing : status == ParseStatus::NOT_A_NUMBER ? notANumber : outOfRange;
+  }
+};
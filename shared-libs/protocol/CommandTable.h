@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CommandFields.h"
+#include "FixedWriter.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string_view>
+
+// Integer argument of a command: the KEY=VAL field key, or "" for the whole body
+// ("SP:<n>"), and its accepted bounds
+struct CommandField {
+  const char *key;
+  int min;
+  int max;
+};
+
+// Responses for an argument that is missing, not a number, or out of its bounds
+struct CommandErrors {
+  const char *missing;
+  const char *notANumber;
+  const char *outOfRange;
+};
+
+// Response of a command, written in place by its handler: one outbound message at most
+using CommandReply = FixedWriter<128>;
+
+// What a handler receives: the whole command, the text after the verb, and the
+// validated integer arguments in the order of the command's fields
+struct CommandArgs {
+  static constexpr size_t MAX_FIELDS = 3;
+
+  std::string_view command;
+  std::string_view body;
+  int values[MAX_FIELDS];
+};
+
+// One RX command. The verb is the command up to its first ':' included ("CFG:"), or
+// the whole command when it has none ("CFG?", "START"). Fields are validated before
+// the handler runs, which then only sees values within their bounds.
+template <typename Owner> struct Command {
+  using Handler = void (Owner::*)(const CommandArgs &args, CommandReply &reply);
+
+  const char *verb = nullptr;
+  Handler handler = nullptr;
+  CommandErrors errors = {};
+  CommandField fields[CommandArgs::MAX_FIELDS] = {};
+};
+
+// Compile-time table of the commands of a protocol, looked up through a perfect hash:
+// one FNV-1a hash of the verb and one comparison, whatever the number of commands.
+// Slots is the hash table size; check the table with static_assert(isPerfect()) where
+// the owner's members are accessible, and grow Slots when two verbs collide.
+template <typename Owner, size_t N, size_t Slots = 4 * N> class CommandTable {
+public:
+  constexpr explicit CommandTable(const Command<Owner> (&commands)[N]) : _commands(), _slots() {
+    for (size_t i = 0; i < N; i++) {
+      _commands[i] = commands[i];
+    }
+    for (size_t i = 0; i < Slots; i++) {
+      _slots[i] = EMPTY;
+    }
+    for (size_t i = 0; i < N; i++) {
+      const size_t slot = slotOf(commands[i].verb);
+      // A collision leaves the slot to the first verb, isPerfect() reports it
+      if (_slots[slot] == EMPTY) {
+        _slots[slot] = static_cast<uint8_t>(i);
+      }
+    }
+  }
+
+  // True when every verb has a slot of its own
+  constexpr bool isPerfect() const {
+    for (size_t i = 0; i < N; i++) {
+      if (_slots[slotOf(_commands[i].verb)] != i) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Runs the command on owner, which writes its response into reply; writes unknown when
+  // no verb matches
+  void dispatch(Owner &owner, std::string_view rx, const char *unknown, CommandReply &reply) const {
+    const size_t colon = rx.find(':');
+    const std::string_view verb = colon == std::string_view::npos ? rx : rx.substr(0, colon + 1);
+    const uint8_t index = _slots[slotOf(verb)];
+    if (index == EMPTY || verb != _commands[index].verb) {
+      reply.append(unknown);
+      return;
+    }
+
+    const Command<Owner> &command = _commands[index];
+    CommandArgs args = {rx, rx.substr(verb.size()), {}};
+    ParseStatus status = ParseStatus::OK;
+    const CommandFields fields(args.body);
+    for (size_t i = 0; i < CommandArgs::MAX_FIELDS && command.fields[i].key != nullptr; i++) {
+      const CommandField &field = command.fields[i];
+      const ParseStatus fieldStatus = field.key[0] == '\0'
+                                          ? parseInt(args.body, field.min, field.max, args.values[i])
+                                          : fields.getInt(field.key, field.min, field.max, args.values[i]);
+      status = fieldStatus > status ? fieldStatus : status;
+    }
+    if (status != ParseStatus::OK) {
+      reply.append(CommandFields::errorFor(status, command.errors.missing, command.errors.notANumber,
+                                           command.errors.outOfRange));
+      return;
+    }
+    (owner.*command.handler)(args, reply);
+  }
+
+private:
+  static constexpr uint8_t EMPTY = 0xFF;
+  static_assert(N < EMPTY, "Too many commands for the slot index");
+
+  Command<Owner> _commands[N];
+  uint8_t _slots[Slots];
+
+  static constexpr size_t slotOf(std::string_view verb) {
+    uint32_t hash = 2166136261u;
+    for (char c : verb) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash % Slots;
+  }
+};
@@ -0,0 +1,57 @@
+#include "TelemetryProtocol.h"
+
+TelemetryProtocol::TelemetryProtocol(TelemetrySettings *settings, TelemetryGate *gate)
+    : _settings(settings), _gate(gate) {}
+
+// A zero deadband publishes every change, a heartbeat is always needed
+constexpr CommandTable<TelemetryProtocol, 5> TelemetryProtocol::COMMANDS({
+    {"TLM?", &TelemetryProtocol::readThresholds},
+    {"TLM:",
+     &TelemetryProtocol::writeThresholds,
+     {"ERR_TLM_FMT", "ERR_TLM_NUM", "ERR_TLM_RANGE"},
+     {{"DB", 0, MAX_DEADBAND}, {"HB", 1, MAX_HEARTBEAT_SECONDS}}},
+    {"CAP?", &TelemetryProtocol::readCapabilities},
+    {"FMT?", &TelemetryProtocol::readFormat},
+    {"FMT:", &TelemetryProtocol::writeFormat},
+});
+
+void TelemetryProtocol::begin() {
+  _gate->configure(_settings->getDeadband(), _settings->getHeartbeatSeconds() * 1000UL);
+}
+
+void TelemetryProtocol::handle(std::string_view rx, CommandReply &reply) {
+  static_assert(COMMANDS.isPerfect(), "Two verbs share a hash slot");
+  COMMANDS.dispatch(*this, rx, "", reply);
+}
+
+void TelemetryProtocol::readThresholds(const CommandArgs &, CommandReply &reply) {
+  const int db = _settings->getDeadband();
+  const int hb = _settings->getHeartbeatSeconds();
+  reply.append("TLM:DB=").appendInt(db).append(";HB=").appendInt(hb);
+}
+
+void TelemetryProtocol::writeThresholds(const CommandArgs &args, CommandReply &reply) {
+  const int db = args.values[0];
+  const int hb = args.values[1];
+  _settings->setThresholds(db, hb);
+  _gate->configure(db, hb * 1000UL);
+  reply.append("OK");
+}
+
+void TelemetryProtocol::readCapabilities(const CommandArgs &, CommandReply &reply) { reply.append("CAP:FMT=TXT,BIN"); }
+
+void TelemetryProtocol::readFormat(const CommandArgs &, CommandReply &reply) {
+  reply.append(_format == BINARY ? "FMT:BIN" : "FMT:TXT");
+}
+
+void TelemetryProtocol::writeFormat(const CommandArgs &args, CommandReply &reply) {
+  if (args.body == "TXT") {
+    _format = TEXT;
+  } else if (args.body == "BIN") {
+    _format = BINARY;
+  } else {
+    reply.append("ERR_FMT");
+    return;
+  }
+  reply.append("OK");
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CommandTable.h"
+#include "TelemetryGate.h"
+#include "TelemetrySettings.h"
+#include <string_view>
+
+// RX commands:
+// - "TLM?"                        -> responds "TLM:DB=<deadband>;HB=<seconds>"
+// - "TLM:DB=<deadband>;HB=<s>"    -> persists, applies + responds "OK" or "ERR_*"
+// - "CAP?"                        -> responds "CAP:FMT=TXT,BIN" (telemetry formats offered)
+// - "FMT?"                        -> responds "FMT:TXT" or "FMT:BIN"
+// - "FMT:TXT" / "FMT:BIN"         -> selects the telemetry format + responds "OK" or "ERR_FMT"
+// Any other input -> empty string (not handled by this protocol)
+// The format is not persisted: every new subscriber starts with ASCII telemetry.
+class TelemetryProtocol {
+public:
+  enum Format { TEXT, BINARY };
+
+private:
+  TelemetrySettings *_settings;
+  TelemetryGate *_gate;
+  Format _format = TEXT;
+
+  static const CommandTable<TelemetryProtocol, 5> COMMANDS;
+
+  void readThresholds(const CommandArgs &args, CommandReply &reply);
+  void writeThresholds(const CommandArgs &args, CommandReply &reply);
+  void readCapabilities(const CommandArgs &args, CommandReply &reply);
+  void readFormat(const CommandArgs &args, CommandReply &reply);
+  void writeFormat(const CommandArgs &args, CommandReply &reply);
+
+public:
+  TelemetryProtocol(TelemetrySettings *settings, TelemetryGate *gate);
+  // Configures the gate from the persisted thresholds
+  void begin();
+  // Writes the response into reply
+  void handle(std::string_view rx, CommandReply &reply);
+  Format getFormat() const { return _format; }
+  void resetFormat() { _format = TEXT; }
+
+  static constexpr int MAX_DEADBAND = 10000;
+  static constexpr int MAX_HEARTBEAT_SECONDS = 3600;
+};
@@ -0,0 +1,15 @@
+#pragma once
+#include <Arduino.h>
+
+// Time source of the scheduler, in milliseconds, wrapping like millis().
+// The firmware uses MillisClock; host tests drive a clock of their own in simulated time.
+class Clock {
+public:
+  virtual ~Clock() = default;
+  virtual unsigned long now() = 0;
+};
+
+class MillisClock : public Clock {
+public:
+  unsigned long now() override { return millis(); }
+};
@@ -0,0 +1,55 @@
+#include "Scheduler.h"
+
+int Scheduler::every(const char *name, unsigned long periodMs, Callback callback, void *context) {
+  if (_count == MAX_TASKS) {
+    LOG_WARN(_logger, "No task left for %s (MAX_TASKS %u)", name, static_cast<unsigned>(MAX_TASKS));
+    return -1;
+  }
+  _tasks[_count] = {name, periodMs > 0 ? periodMs : 1, callback, context, _clock->now(), {}};
+  return static_cast<int>(_count++);
+}
+
+void Scheduler::tick() {
+  for (size_t i = 0; i < _count; i++) {
+    const unsigned long now = _clock->now();
+    if (reached(now, _tasks[i].releaseAt)) {
+      run(_tasks[i], now);
+    }
+  }
+}
+
+void Scheduler::run(Task &task, unsigned long now) {
+  const unsigned long release = task.releaseAt;
+  task.callback(task.context);
+  const unsigned long end = _clock->now();
+
+  Stats &stats = task.stats;
+  const unsigned long lateness = now - release;
+  const unsigned long runMs = end - now;
+  stats.runs++;
+  stats.maxLatenessMs = lateness > stats.maxLatenessMs ? lateness : stats.maxLatenessMs;
+  stats.maxRunMs = runMs > stats.maxRunMs ? runMs : stats.maxRunMs;
+
+  task.releaseAt = release + task.periodMs;
+  if (!reached(task.releaseAt, end)) {
+    // Ended past its deadline: skip the releases that went by, keep the phase
+    const unsigned long missed = (end - task.releaseAt + task.periodMs - 1) / task.periodMs;
+    task.releaseAt += missed * task.periodMs;
+    stats.overruns++;
+    LOG_WARN(_logger, "Task %s overran its %lu ms period: started %lu ms late, ran %lu ms, %lu release(s) skipped",
+             task.name, task.periodMs, lateness, runMs, missed);
+  }
+}
+
+unsigned long Scheduler::idleMs() {
+  const unsigned long now = _clock->now();
+  unsigned long idle = 0;
+  for (size_t i = 0; i < _count; i++) {
+    if (reached(now, _tasks[i].releaseAt)) {
+      return 0;
+    }
+    const unsigned long left = _tasks[i].releaseAt - now;
+    idle = (i == 0 || left < idle) ? left : idle;
+  }
+  return idle;
+}
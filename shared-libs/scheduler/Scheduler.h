@@ -0,0 +1,62 @@
+#pragma once
+#include "Clock.h"
+#include "Logger.h"
+#include <stddef.h>
+
+// Cooperative scheduler of periodic tasks, run from the main loop: tick() runs the tasks
+// whose release time came, then the loop sleeps idleMs() until the next one. Each
+// subsystem runs at its own rate instead of every task at the pace of the slowest.
+// A task must finish before its next release (its deadline). One that ends past it has
+// overrun: the overrun is counted and logged, and the releases it missed are skipped
+// rather than run back to back, keeping the task on its original phase.
+class Scheduler {
+public:
+  static constexpr size_t MAX_TASKS = 8;
+
+  using Callback = void (*)(void *context);
+
+  struct Stats {
+    unsigned long runs;
+    unsigned long overruns;
+    // Worst delay between a release and the start of its run
+    unsigned long maxLatenessMs;
+    unsigned long maxRunMs;
+  };
+
+  Scheduler(Clock &clock, Logger *logger) : _clock(&clock), _logger(logger) {}
+
+  // Runs callback(context) every periodMs, first at the next tick(). Returns the task id,
+  // or -1 (logged) when the MAX_TASKS tasks are taken. name must outlive the scheduler.
+  int every(const char *name, unsigned long periodMs, Callback callback, void *context);
+  // Same with a member function: every<Program, &Program::sample>("sample", 100, this)
+  template <typename T, void (T::*Method)()> int every(const char *name, unsigned long periodMs, T *object) {
+    return every(name, periodMs, [](void *context) { (static_cast<T *>(context)->*Method)(); }, object);
+  }
+
+  // Runs each due task once, in registration order
+  void tick();
+  // Time left until the next release, 0 when a task is already due
+  unsigned long idleMs();
+
+  size_t getTaskCount() const { return _count; }
+  const Stats &getStats(int task) const { return _tasks[task].stats; }
+
+private:
+  struct Task {
+    const char *name;
+    unsigned long periodMs;
+    Callback callback;
+    void *context;
+    unsigned long releaseAt;
+    Stats stats;
+  };
+
+  Clock *_clock;
+  Logger *_logger;
+  Task _tasks[MAX_TASKS];
+  size_t _count = 0;
+
+  // at is now or past, whichever way millis() wrapped in between
+  static bool reached(unsigned long now, unsigned long at) { return static_cast<long>(now - at) >= 0; }
+  void run(Task &task, unsigned long now);
+};
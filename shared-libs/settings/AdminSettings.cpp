@@ -1,11 +1,32 @@
 #include "AdminSettings.h"
+#include <cstring>
 
 std::string AdminSettings::getDeviceName(std::string defaultName) {
   return std::string(_settings->get("device_name", defaultName).c_str());
 }
 
-void AdminSettings::setDeviceName(std::string newName) { _settings->save("device_name", newName.c_str()); }
+void AdminSettings::setDeviceName(std::string_view newName) {
+  char name[MAX_NAME_LENGTH + 1];
+  const size_t length = newName.size() < MAX_NAME_LENGTH ? newName.size() : MAX_NAME_LENGTH;
+  memcpy(name, newName.data(), length);
+  name[length] = '\0';
+
+  _settings->beginTransaction();
+  _settings->save("device_name", name);
+  _settings->commit();
+}
 
 uint32_t AdminSettings::getPinCode() { return _settings->get("pin_code", 123456); }
 
-void AdminSettings::setPinCode(uint32_t newPin) { _settings->save("pin_code", static_cast<int>(newPin)); }
\ No newline at end of file
+void AdminSettings::setPinCode(uint32_t newPin) {
+  _settings->beginTransaction();
+  _settings->save("pin_code", static_cast<int>(newPin));
+  _settings->commit();
+}
+
+void AdminSettings::setIdentity(std::string_view newName, uint32_t newPin) {
+  _settings->beginTransaction();
+  setDeviceName(newName);
+  setPinCode(newPin);
+  _settings->commit();
+}
\ No newline at end of file
@@ -1,15 +1,22 @@
 #pragma once
 #include "Settings.h"
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 class AdminSettings {
   Settings *_settings = nullptr;
 
 public:
+  // Longer names are cut when saved
+  static constexpr size_t MAX_NAME_LENGTH = 20;
+
   AdminSettings(Settings *settings) : _settings(settings) {}
   std::string getDeviceName(std::string defaultName);
-  void setDeviceName(std::string newName);
+  void setDeviceName(std::string_view newName);
   uint32_t getPinCode();
   void setPinCode(uint32_t newPin);
+  // Persists name and PIN together, in one settings transaction
+  void setIdentity(std::string_view newName, uint32_t newPin);
 };
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "CachedSettings.h"
+#include <cstring>
+
+CachedSettings::CachedSettings(Settings *backend) : _backend(backend), _dirty(false), _transactionDepth(0) {}
+
+int CachedSettings::get(const char *key, const int defaultValue) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (IntEntry *entry = find(_ints, _intCount, key)) {
+    return entry->value;
+  }
+
+  const int value = _backend->get(key, defaultValue);
+  if (IntEntry *entry = add(_ints, _intCount, key)) {
+    entry->value = value;
+    entry->dirty = false;
+  }
+  return value;
+}
+
+void CachedSettings::save(const char *key, const int value) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  IntEntry *entry = find(_ints, _intCount, key);
+  if (entry != nullptr && entry->value == value) {
+    return;
+  }
+  if (entry == nullptr) {
+    entry = add(_ints, _intCount, key);
+  }
+
+  if (entry != nullptr) {
+    entry->value = value;
+    entry->dirty = true;
+  } else {
+    _backend->save(key, value);
+  }
+  _dirty = true;
+}
+
+std::string CachedSettings::get(const char *key, const std::string defaultValue) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (StringEntry *entry = find(_strings, _stringCount, key)) {
+    return entry->value;
+  }
+
+  const std::string value = _backend->get(key, defaultValue);
+  if (!fitsString(value.c_str())) {
+    return value;
+  }
+  if (StringEntry *entry = add(_strings, _stringCount, key)) {
+    strcpy(entry->value, value.c_str());
+    entry->dirty = false;
+  }
+  return value;
+}
+
+void CachedSettings::save(const char *key, const char *value) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  StringEntry *entry = find(_strings, _stringCount, key);
+  if (entry != nullptr && strcmp(entry->value, value) == 0) {
+    return;
+  }
+  if (!fitsString(value)) {
+    // Too long to cache: the stale entry goes, the value is written through
+    if (entry != nullptr) {
+      *entry = _strings[--_stringCount];
+    }
+    entry = nullptr;
+  } else if (entry == nullptr) {
+    entry = add(_strings, _stringCount, key);
+  }
+
+  if (entry != nullptr) {
+    strcpy(entry->value, value);
+    entry->dirty = true;
+  } else {
+    _backend->save(key, value);
+  }
+  _dirty = true;
+}
+
+void CachedSettings::flush() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_transactionDepth == 0) {
+    writeBack();
+  }
+}
+
+void CachedSettings::beginTransaction() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _transactionDepth++;
+}
+
+void CachedSettings::commit() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_transactionDepth > 0) {
+    _transactionDepth--;
+  }
+  if (_transactionDepth == 0) {
+    writeBack();
+  }
+}
+
+template <typename Entry, size_t N>
+Entry *CachedSettings::find(Entry (&entries)[N], size_t count, const char *key) {
+  for (size_t i = 0; i < count; i++) {
+    if (strcmp(entries[i].key, key) == 0) {
+      return &entries[i];
+    }
+  }
+  return nullptr;
+}
+
+template <typename Entry, size_t N>
+Entry *CachedSettings::add(Entry (&entries)[N], size_t &count, const char *key) {
+  if (count == N || strlen(key) > SettingsKey::MAX_LENGTH) {
+    return nullptr;
+  }
+  Entry &entry = entries[count++];
+  strcpy(entry.key, key);
+  return &entry;
+}
+
+bool CachedSettings::fitsString(const char *value) { return strlen(value) <= MAX_STRING_LENGTH; }
+
+void CachedSettings::writeBack() {
+  if (!_dirty) {
+    return;
+  }
+
+  for (size_t i = 0; i < _intCount; i++) {
+    if (_ints[i].dirty) {
+      _backend->save(_ints[i].key, _ints[i].value);
+      _ints[i].dirty = false;
+    }
+  }
+  for (size_t i = 0; i < _stringCount; i++) {
+    if (_strings[i].dirty) {
+      _backend->save(_strings[i].key, _strings[i].value);
+      _strings[i].dirty = false;
+    }
+  }
+
+  _backend->flush();
+  _dirty = false;
+}
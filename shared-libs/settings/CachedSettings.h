@@ -0,0 +1,65 @@
+#pragma once
+#include "Settings.h"
+#include "SettingsKey.h"
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+// Settings decorator keeping every key it has seen in RAM, in tables sized at compile
+// time: reading or saving a cached key never allocates.
+// A key is read from the backend once, then served from the cache. Saves only update
+// the cache and mark the key dirty: flush() writes every dirty key back and commits
+// the backend once. Saving the value a key already holds writes nothing.
+// While a transaction is open, flush() is deferred to its commit(), so the keys of a
+// transaction always reach the backend together.
+// A key the tables have no room for, or a string longer than MAX_STRING_LENGTH, is read
+// and saved through to the backend (still committed by flush()).
+// Safe to share between the loop and the BLE host task.
+// A key must always be read with the same default: the backend does not tell a stored
+// value from the default it returned for a missing key, so the first one is cached.
+class CachedSettings : public Settings {
+public:
+  // The heater module reads about 40 integer keys, the water module 3 strings
+  static constexpr size_t MAX_INTS = 48;
+  static constexpr size_t MAX_STRINGS = 4;
+  // Longest string cached: a tank calibration table (80 characters)
+  static constexpr size_t MAX_STRING_LENGTH = 95;
+
+  explicit CachedSettings(Settings *backend);
+
+  int get(const char *key, const int defaultValue) override;
+  void save(const char *key, const int value) override;
+  std::string get(const char *key, const std::string defaultValue) override;
+  void save(const char *key, const char *value) override;
+  void flush() override;
+  void beginTransaction() override;
+  void commit() override;
+
+private:
+  struct IntEntry {
+    char key[SettingsKey::MAX_LENGTH + 1];
+    int value;
+    bool dirty;
+  };
+  struct StringEntry {
+    char key[SettingsKey::MAX_LENGTH + 1];
+    char value[MAX_STRING_LENGTH + 1];
+    bool dirty;
+  };
+
+  Settings *_backend;
+  IntEntry _ints[MAX_INTS];
+  size_t _intCount = 0;
+  StringEntry _strings[MAX_STRINGS];
+  size_t _stringCount = 0;
+  bool _dirty;
+  int _transactionDepth;
+  std::mutex _mutex;
+
+  // The entry of key, null when not cached
+  template <typename Entry, size_t N> static Entry *find(Entry (&entries)[N], size_t count, const char *key);
+  // A new entry for key, null when the table is full or the key too long for NVS
+  template <typename Entry, size_t N> static Entry *add(Entry (&entries)[N], size_t &count, const char *key);
+  static bool fitsString(const char *value);
+  void writeBack();
+};
@@ -4,8 +4,18 @@
 
 class Settings {
 public:
+  virtual ~Settings() = default;
+
   virtual int get(const char *key, const int defaultValue) = 0;
   virtual void save(const char *key, const int value) = 0;
   virtual std::string get(const char *key, const std::string defaultValue) = 0;
   virtual void save(const char *key, const char *value) = 0;
-};
\ No newline at end of file
+
+  // Persist every buffered save (no-op for stores writing through)
+  virtual void flush() {}
+
+  // Group the saves up to the matching commit() into a single write
+  // Transactions nest: only the outermost commit() persists.
+  virtual void beginTransaction() {}
+  virtual void commit() { flush(); }
+};
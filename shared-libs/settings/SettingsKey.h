@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+
+// Settings key built once from an instance name and a suffix ("grey_tank" + "_v_l"),
+// so lookups hand the store a ready C string instead of concatenating on each call.
+// NVS rejects keys longer than MAX_LENGTH characters: a longer key is truncated, check
+// names known at compile time with fits().
+class SettingsKey {
+public:
+  static constexpr size_t MAX_LENGTH = 15;
+
+  SettingsKey(const char *name, const char *suffix) {
+    size_t length = 0;
+    for (; *name != '\0' && length < MAX_LENGTH; name++) {
+      _key[length++] = *name;
+    }
+    for (; *suffix != '\0' && length < MAX_LENGTH; suffix++) {
+      _key[length++] = *suffix;
+    }
+    _key[length] = '\0';
+  }
+
+  const char *c_str() const { return _key; }
+
+  static constexpr size_t length(const char *text) { return *text == '\0' ? 0 : 1 + length(text + 1); }
+
+  // True when name + suffix fits the NVS limit, usable in a static_assert
+  static constexpr bool fits(const char *name, const char *suffix) {
+    return length(name) + length(suffix) <= MAX_LENGTH;
+  }
+
+private:
+  char _key[MAX_LENGTH + 1];
+};
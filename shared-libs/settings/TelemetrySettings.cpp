@@ -0,0 +1,14 @@
+#include "TelemetrySettings.h"
+
+int TelemetrySettings::getDeadband() { return _settings->get(_deadbandKey.c_str(), DEFAULT_DEADBAND); }
+
+int TelemetrySettings::getHeartbeatSeconds() {
+  return _settings->get(_heartbeatKey.c_str(), DEFAULT_HEARTBEAT_SECONDS);
+}
+
+void TelemetrySettings::setThresholds(int deadband, int heartbeatSeconds) {
+  _settings->beginTransaction();
+  _settings->save(_deadbandKey.c_str(), deadband);
+  _settings->save(_heartbeatKey.c_str(), heartbeatSeconds);
+  _settings->commit();
+}
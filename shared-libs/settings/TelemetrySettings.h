@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Settings.h"
+#include "SettingsKey.h"
+
+// Telemetry publishing thresholds of one channel (see TelemetryGate)
+class TelemetrySettings {
+  static constexpr const char *DEADBAND_SUFFIX = "_db";
+  static constexpr const char *HEARTBEAT_SUFFIX = "_hb";
+
+  Settings *_settings = nullptr;
+  SettingsKey _deadbandKey;
+  SettingsKey _heartbeatKey;
+
+public:
+  TelemetrySettings(Settings *settings, const char *name)
+      : _settings(settings), _deadbandKey(name, DEADBAND_SUFFIX), _heartbeatKey(name, HEARTBEAT_SUFFIX) {}
+
+  // True when every key of a channel with this name fits the NVS limit
+  static constexpr bool fitsName(const char *name) {
+    return SettingsKey::fits(name, DEADBAND_SUFFIX) && SettingsKey::fits(name, HEARTBEAT_SUFFIX);
+  }
+
+  // Deadband in the unit the channel transmits (tenths of degree, mm...)
+  int getDeadband();
+  int getHeartbeatSeconds();
+  // Persists both thresholds together, in one settings transaction
+  void setThresholds(int deadband, int heartbeatSeconds);
+
+  static constexpr int DEFAULT_DEADBAND = 1;
+  static constexpr int DEFAULT_HEARTBEAT_SECONDS = 10;
+};
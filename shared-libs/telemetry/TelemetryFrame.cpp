@@ -0,0 +1,171 @@
+#include "TelemetryFrame.h"
+
+namespace {
+void writeUint16(uint8_t *out, uint16_t value) {
+  out[0] = static_cast<uint8_t>(value & 0xFF);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+uint16_t readUint16(const uint8_t *in) { return static_cast<uint16_t>(in[0] | (in[1] << 8)); }
+
+void writeInt16(uint8_t *out, int16_t value) { writeUint16(out, static_cast<uint16_t>(value)); }
+
+int16_t readInt16(const uint8_t *in) { return static_cast<int16_t>(readUint16(in)); }
+
+void writeEnvironment(uint8_t *out, const TelemetryFrame::Environment &environment) {
+  writeInt16(out, environment.temperature);
+  writeUint16(out + 2, environment.humidity);
+  writeUint16(out + 4, environment.pressure);
+  writeInt16(out + 6, environment.exterior);
+}
+
+void readEnvironment(const uint8_t *in, TelemetryFrame::Environment &environment) {
+  environment.temperature = readInt16(in);
+  environment.humidity = readUint16(in + 2);
+  environment.pressure = readUint16(in + 4);
+  environment.exterior = readInt16(in + 6);
+}
+
+// Writes the header before the payload and the CRC after it, returns the frame length
+size_t seal(uint8_t *out, TelemetryFrame::Type type, uint8_t sequence, size_t payloadSize) {
+  out[0] = type;
+  out[1] = sequence;
+  const size_t crcOffset = TelemetryFrame::HEADER_SIZE + payloadSize;
+  writeUint16(out + crcOffset, TelemetryFrame::crc16(out, crcOffset));
+  return crcOffset + TelemetryFrame::CRC_SIZE;
+}
+
+// Checks type, length and CRC of a received frame, and reads its sequence number
+bool unseal(const uint8_t *frame, size_t length, TelemetryFrame::Type type, size_t expectedLength,
+          uint8_t &sequence) {
+  if (length != expectedLength || frame[0] != type) {
+    return false;
+  }
+  const size_t crcOffset = length - TelemetryFrame::CRC_SIZE;
+  if (readUint16(frame + crcOffset) != TelemetryFrame::crc16(frame, crcOffset)) {
+    return false;
+  }
+  sequence = frame[1];
+  return true;
+}
+} // namespace
+
+size_t TelemetryFrame::encode(const HeaterStatus &status, uint8_t sequence, uint8_t *out) {
+  uint8_t *payload = out + HEADER_SIZE;
+  writeInt16(payload, status.temperature);
+  writeInt16(payload + 2, status.setpoint);
+  payload[4] = status.running ? 1 : 0;
+  return seal(out, HEATER_STATUS, sequence, 5);
+}
+
+size_t TelemetryFrame::encode(const Environment &environment, uint8_t sequence, uint8_t *out) {
+  writeEnvironment(out + HEADER_SIZE, environment);
+  return seal(out, ENVIRONMENT, sequence, 8);
+}
+
+size_t TelemetryFrame::encode(const TankLevel &level, uint8_t sequence, uint8_t *out) {
+  writeUint16(out + HEADER_SIZE, level.distanceMm);
+  return seal(out, TANK_LEVEL, sequence, 2);
+}
+
+size_t TelemetryFrame::encode(const TankVolume &volume, uint8_t sequence, uint8_t *out) {
+  writeUint16(out + HEADER_SIZE, volume.deciLiters);
+  writeInt16(out + HEADER_SIZE + 2, volume.deciLitersPerMinute);
+  return seal(out, TANK_VOLUME, sequence, 4);
+}
+
+size_t TelemetryFrame::encode(const HeaterSnapshot &snapshot, uint8_t sequence, uint8_t *out) {
+  uint8_t *payload = out + HEADER_SIZE;
+  for (size_t i = 0; i < SNAPSHOT_ZONES; i++, payload += 6) {
+    const Zone &zone = snapshot.zones[i];
+    writeInt16(payload, zone.temperature);
+    writeInt16(payload + 2, zone.setpoint);
+    payload[4] = zone.running ? 1 : 0;
+    payload[5] = zone.fanOutput;
+  }
+  writeEnvironment(payload, snapshot.environment);
+  return seal(out, HEATER_SNAPSHOT, sequence, SNAPSHOT_ZONES * 6 + 8);
+}
+
+bool TelemetryFrame::decode(const uint8_t *frame, size_t length, HeaterStatus &status, uint8_t &sequence) {
+  if (!unseal(frame, length, HEATER_STATUS, HEATER_STATUS_SIZE, sequence)) {
+    return false;
+  }
+  const uint8_t *payload = frame + HEADER_SIZE;
+  status.temperature = readInt16(payload);
+  status.setpoint = readInt16(payload + 2);
+  status.running = payload[4] != 0;
+  return true;
+}
+
+bool TelemetryFrame::decode(const uint8_t *frame, size_t length, Environment &environment, uint8_t &sequence) {
+  if (!unseal(frame, length, ENVIRONMENT, ENVIRONMENT_SIZE, sequence)) {
+    return false;
+  }
+  readEnvironment(frame + HEADER_SIZE, environment);
+  return true;
+}
+
+bool TelemetryFrame::decode(const uint8_t *frame, size_t length, TankLevel &level, uint8_t &sequence) {
+  if (!unseal(frame, length, TANK_LEVEL, TANK_LEVEL_SIZE, sequence)) {
+    return false;
+  }
+  level.distanceMm = readUint16(frame + HEADER_SIZE);
+  return true;
+}
+
+bool TelemetryFrame::decode(const uint8_t *frame, size_t length, TankVolume &volume, uint8_t &sequence) {
+  if (!unseal(frame, length, TANK_VOLUME, TANK_VOLUME_SIZE, sequence)) {
+    return false;
+  }
+  volume.deciLiters = readUint16(frame + HEADER_SIZE);
+  volume.deciLitersPerMinute = readInt16(frame + HEADER_SIZE + 2);
+  return true;
+}
+
+bool TelemetryFrame::decode(const uint8_t *frame, size_t length, HeaterSnapshot &snapshot, uint8_t &sequence) {
+  if (!unseal(frame, length, HEATER_SNAPSHOT, HEATER_SNAPSHOT_SIZE, sequence)) {
+    return false;
+  }
+  const uint8_t *payload = frame + HEADER_SIZE;
+  for (size_t i = 0; i < SNAPSHOT_ZONES; i++, payload += 6) {
+    Zone &zone = snapshot.zones[i];
+    zone.temperature = readInt16(payload);
+    zone.setpoint = readInt16(payload + 2);
+    zone.running = payload[4] != 0;
+    zone.fanOutput = payload[5];
+  }
+  readEnvironment(payload, snapshot.environment);
+  return true;
+}
+
+uint16_t TelemetryFrame::crc16(const uint8_t *data, size_t length) {
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= static_cast<uint16_t>(data[i] << 8);
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+int16_t TelemetryFrame::toInt16(int value) {
+  if (value > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (value < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return static_cast<int16_t>(value);
+}
+
+uint16_t TelemetryFrame::toUint16(int value) {
+  if (value > UINT16_MAX) {
+    return UINT16_MAX;
+  }
+  if (value < 0) {
+    return 0;
+  }
+  return static_cast<uint16_t>(value);
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Binary telemetry frames, the opt-in alternative to the ASCII notifications.
+// Layout: [type][sequence][payload][crc16], every field little-endian, the CRC
+// (CRC-16/CCITT-FALSE) covering type, sequence and payload. Values keep the unit of their
+// ASCII counterpart. Types stay below 0x20 so a client tells a frame from ASCII text by its
+// first byte; a frame longer than the notification (the heater snapshot on a 23-byte MTU)
+// arrives split across consecutive notifications, reassembled by its fixed length.
+class TelemetryFrame {
+public:
+  enum Type : uint8_t {
+    HEATER_STATUS = 0x01,
+    ENVIRONMENT = 0x02,
+    TANK_LEVEL = 0x03,
+    HEATER_SNAPSHOT = 0x04,
+    TANK_VOLUME = 0x05,
+  };
+
+  // STATUS:T=<temp>;SP=<sp>;RUN=<0/1>
+  struct HeaterStatus {
+    int16_t temperature;
+    int16_t setpoint;
+    bool running;
+  };
+
+  // ENV:T=<temp>;H=<humidity>;P=<pressure>;EXT=<ext>
+  struct Environment {
+    int16_t temperature;
+    uint16_t humidity;
+    uint16_t pressure;
+    int16_t exterior;
+  };
+
+  // <mm>
+  struct TankLevel {
+    uint16_t distanceMm;
+  };
+
+  // VOL:V=<volume>;R=<rate>, tenths of liter and tenths of liter per minute, the rate
+  // positive when filling
+  struct TankVolume {
+    uint16_t deciLiters;
+    int16_t deciLitersPerMinute;
+  };
+
+  static constexpr size_t SNAPSHOT_ZONES = 4;
+
+  struct Zone {
+    int16_t temperature;
+    int16_t setpoint;
+    bool running;
+    uint8_t fanOutput;
+  };
+
+  // SNAP:T=<t0>,...;SP=<sp0>,...;RUN=<run0>,...;FAN=<fan0>,...;ENV=<temp>,<humidity>,<pressure>,<ext>
+  struct HeaterSnapshot {
+    Zone zones[SNAPSHOT_ZONES];
+    Environment environment;
+  };
+
+  static constexpr size_t HEADER_SIZE = 2;
+  static constexpr size_t CRC_SIZE = 2;
+  static constexpr size_t HEATER_STATUS_SIZE = HEADER_SIZE + 5 + CRC_SIZE;
+  static constexpr size_t ENVIRONMENT_SIZE = HEADER_SIZE + 8 + CRC_SIZE;
+  static constexpr size_t TANK_LEVEL_SIZE = HEADER_SIZE + 2 + CRC_SIZE;
+  static constexpr size_t TANK_VOLUME_SIZE = HEADER_SIZE + 4 + CRC_SIZE;
+  static constexpr size_t HEATER_SNAPSHOT_SIZE = HEADER_SIZE + SNAPSHOT_ZONES * 6 + 8 + CRC_SIZE;
+  static constexpr size_t MAX_SIZE = HEATER_SNAPSHOT_SIZE;
+
+  // Each encode() writes the whole frame to out (MAX_SIZE bytes) and returns its length
+  static size_t encode(const HeaterStatus &status, uint8_t sequence, uint8_t *out);
+  static size_t encode(const Environment &environment, uint8_t sequence, uint8_t *out);
+  static size_t encode(const TankLevel &level, uint8_t sequence, uint8_t *out);
+  static size_t encode(const TankVolume &volume, uint8_t sequence, uint8_t *out);
+  static size_t encode(const HeaterSnapshot &snapshot, uint8_t sequence, uint8_t *out);
+
+  // Each decode() fails on a wrong type, length or CRC
+  static bool decode(const uint8_t *frame, size_t length, HeaterStatus &status, uint8_t &sequence);
+  static bool decode(const uint8_t *frame, size_t length, Environment &environment, uint8_t &sequence);
+  static bool decode(const uint8_t *frame, size_t length, TankLevel &level, uint8_t &sequence);
+  static bool decode(const uint8_t *frame, size_t length, TankVolume &volume, uint8_t &sequence);
+  static bool decode(const uint8_t *frame, size_t length, HeaterSnapshot &snapshot, uint8_t &sequence);
+
+  static uint16_t crc16(const uint8_t *data, size_t length);
+
+  // Saturating conversions of the int values the notifiers compute
+  static int16_t toInt16(int value);
+  static uint16_t toUint16(int value);
+};
@@ -0,0 +1,33 @@
+#include "TelemetryGate.h"
+#include <cstdlib>
+
+void TelemetryGate::configure(int deadband, unsigned long heartbeatMs) {
+  _deadband = deadband;
+  _heartbeatMs = heartbeatMs;
+}
+
+bool TelemetryGate::shouldPublish(const int *values, size_t count, unsigned long nowMs) {
+  if (count > MAX_FIELDS) {
+    count = MAX_FIELDS;
+  }
+  if (_published && nowMs - _publishedAt < _heartbeatMs && !changed(values, count)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    _values[i] = values[i];
+  }
+  _published = true;
+  _publishedAt = nowMs;
+  return true;
+}
+
+bool TelemetryGate::changed(const int *values, size_t count) const {
+  for (size_t i = 0; i < count; i++) {
+    const int delta = std::abs(values[i] - _values[i]);
+    if (i < _measuredFields ? delta > _deadband : delta != 0) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+
+// Decides when a telemetry frame is worth sending.
+// A frame is published when one of its measurements moved by more than the deadband
+// since the last published frame, when one of its states (setpoint, running flag...)
+// changed at all, or when the heartbeat expired: a slow drift is published once it
+// adds up, and the peer still hears from a quiet sensor.
+class TelemetryGate {
+public:
+  // Sized for the heater snapshot (5 fields per zone, see SnapshotListner)
+  static constexpr size_t MAX_FIELDS = 20;
+
+  // The first measuredFields values of a frame are measurements, the others states
+  explicit TelemetryGate(size_t measuredFields) : _measuredFields(measuredFields) {}
+
+  void configure(int deadband, unsigned long heartbeatMs);
+  // Publish the next frame whatever its values (new subscriber, explicit query)
+  void invalidate() { _published = false; }
+  // Records the frame as published when it returns true
+  bool shouldPublish(const int *values, size_t count, unsigned long nowMs);
+
+private:
+  size_t _measuredFields;
+  int _deadband = 0;
+  unsigned long _heartbeatMs = 0;
+  bool _published = false;
+  unsigned long _publishedAt = 0;
+  int _values[MAX_FIELDS] = {};
+
+  bool changed(const int *values, size_t count) const;
+};
@@ -0,0 +1,122 @@
+#include "ChunkedSender.h"
+#include <cstring>
+
+void ChunkedSender::setMtu(uint16_t mtu) {
+  const size_t usable = (mtu > DEFAULT_MTU ? mtu : DEFAULT_MTU) - ATT_HEADER_SIZE;
+  _chunkSize = usable < MAX_CHUNK_SIZE ? usable : MAX_CHUNK_SIZE;
+}
+
+size_t ChunkedSender::getChunkSize() { return _chunkSize; }
+
+bool ChunkedSender::send(const char *message, size_t length, OutboundQueue::Policy policy) {
+  return stage(message, length, policy, OutboundQueue::TEXT);
+}
+
+bool ChunkedSender::sendFrame(const uint8_t *frame, size_t length, OutboundQueue::Policy policy) {
+  return stage(reinterpret_cast<const char *>(frame), length, policy, OutboundQueue::BINARY);
+}
+
+bool ChunkedSender::stage(const char *data, size_t length, OutboundQueue::Policy policy,
+                          OutboundQueue::Encoding encoding) {
+  const size_t slots = policy == OutboundQueue::NEVER_DROP ? STAGING_CAPACITY : STAGING_CAPACITY - REPLY_RESERVE;
+  Staged *staged = length <= OutboundQueue::MAX_MESSAGE_SIZE && _staged.size() < slots ? _staged.claim() : nullptr;
+  if (staged == nullptr) {
+    _refusedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  memcpy(staged->data, data, length);
+  staged->length = length;
+  staged->policy = policy;
+  staged->encoding = encoding;
+  _staged.publish();
+  return true;
+}
+
+void ChunkedSender::unstage() {
+  for (Staged *staged = _staged.front(); staged != nullptr; staged = _staged.front()) {
+    // A reply the queue has no room for stays staged until a chunk goes out
+    if (staged->policy == OutboundQueue::NEVER_DROP && !_queue.canPush()) {
+      return;
+    }
+    _queue.push(staged->data, staged->length, staged->policy, staged->encoding);
+    _staged.pop();
+  }
+}
+
+void ChunkedSender::flush() {
+  unstage();
+  uint8_t chunk[MAX_CHUNK_SIZE];
+  while (!_queue.empty()) {
+    size_t messagesDone = 0;
+    size_t offset = _frontOffset;
+    const size_t length = fillChunk(chunk, messagesDone, offset);
+    if (!transmit(chunk, length)) {
+      _congestionCount++;
+      return;
+    }
+
+    for (size_t i = 0; i < messagesDone; i++) {
+      _queue.pop();
+    }
+    _frontOffset = offset;
+    _queue.holdFront(offset > 0);
+    unstage();
+  }
+}
+
+void ChunkedSender::clear() {
+  while (_staged.front() != nullptr) {
+    _staged.pop();
+  }
+  _queue.clear();
+  _frontOffset = 0;
+}
+
+size_t ChunkedSender::getQueueDepth() { return _queue.size() + _staged.size(); }
+
+size_t ChunkedSender::getMaxQueueDepth() { return _queue.getMaxDepth(); }
+
+unsigned long ChunkedSender::getDropCount() {
+  return _queue.getDropCount() + _refusedCount.load(std::memory_order_relaxed);
+}
+
+unsigned long ChunkedSender::getCongestionCount() { return _congestionCount; }
+
+// Packs the queued messages, from the unsent part of the oldest one, into one chunk.
+// On return, messagesDone counts the messages the chunk completes and offset is how far
+// into the next one it stops.
+size_t ChunkedSender::fillChunk(uint8_t *chunk, size_t &messagesDone, size_t &offset) {
+  size_t length = 0;
+  while (messagesDone < _queue.size() && length < _chunkSize) {
+    const char *data = _queue.data(messagesDone);
+    const size_t messageLength = _queue.length(messagesDone);
+
+    if (_queue.encoding(messagesDone) == OutboundQueue::BINARY) {
+      // A frame gets chunks of its own: it starts the next one after text
+      if (length == 0) {
+        const size_t remaining = messageLength - offset;
+        length = remaining < _chunkSize ? remaining : _chunkSize;
+        memcpy(chunk, data + offset, length);
+        offset += length;
+        if (offset == messageLength) {
+          messagesDone++;
+          offset = 0;
+        }
+      }
+      break;
+    }
+    // End-of-message marker for the mobile app to reassemble chunks
+    const size_t framedLength = messageLength + 1;
+
+    while (offset < framedLength && length < _chunkSize) {
+      chunk[length++] = offset < messageLength ? static_cast<uint8_t>(data[offset]) : '\n';
+      offset++;
+    }
+    if (offset < framedLength) {
+      break;
+    }
+    messagesDone++;
+    offset = 0;
+  }
+  return length;
+}
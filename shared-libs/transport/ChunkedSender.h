@@ -0,0 +1,90 @@
+#pragma once
+#include "OutboundQueue.h"
+#include "SpscQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+// Queues messages for the peer and streams them, from the sender step, in chunks as
+// large as the negotiated ATT MTU allows.
+// Every message ends with the "\n" marker the mobile app reassembles on, so a message
+// that fits goes out in one notification, and consecutive messages share a chunk.
+// send() only queues: the radio is driven by flush(), called once per loop. A chunk the
+// stack refuses (no buffer left) is retried by the next flush().
+// Binary frames (see TelemetryFrame) bypass the marker and never share a chunk: a frame
+// goes out in notifications of its own, split when longer than the chunk.
+// send() and sendFrame() belong to the control task, everything else to the radio task:
+// messages cross over in a lock-free staging ring, flush() moving them into the queue.
+// The ring does not evict: it keeps REPLY_RESERVE slots that only NEVER_DROP messages
+// may take, so telemetry piling up between two flushes cannot push a reply out, and a
+// reply waits in the ring while the queue is full of other replies.
+class ChunkedSender {
+public:
+  // ATT MTU every peer supports, used until a larger one is negotiated
+  static constexpr uint16_t DEFAULT_MTU = 23;
+  // A notification carries the ATT opcode and attribute handle before the value
+  static constexpr uint16_t ATT_HEADER_SIZE = 3;
+  // Longest attribute value allowed by the ATT specification
+  static constexpr size_t MAX_CHUNK_SIZE = 512;
+  // Staging slots only NEVER_DROP messages may take: one reply per command of a full
+  // inbox (see BleInbox), whatever the telemetry staged
+  static constexpr size_t REPLY_RESERVE = 8;
+  static constexpr size_t STAGING_CAPACITY = 16;
+
+  virtual ~ChunkedSender() = default;
+
+  void setMtu(uint16_t mtu);
+  size_t getChunkSize();
+  // Producer side. False when the message is too long or no staging slot is left for
+  // its policy.
+  bool send(const char *message, size_t length, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP);
+  bool send(const std::string &message, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP) {
+    return send(message.data(), message.length(), policy);
+  }
+  // NUL-terminated message, a literal reply for instance
+  bool send(const char *message, OutboundQueue::Policy policy = OutboundQueue::NEVER_DROP) {
+    return send(message, strlen(message), policy);
+  }
+  // Producer side, false when the frame is refused
+  bool sendFrame(const uint8_t *frame, size_t length, OutboundQueue::Policy policy);
+  // Consumer side from here on.
+  // Sends the queued messages until the queue is empty or the stack is congested
+  void flush();
+  // Drops everything queued or staged (peer gone)
+  void clear();
+  // Messages waiting, staged ones included
+  size_t getQueueDepth();
+  size_t getMaxQueueDepth();
+  // Messages evicted by the queue or refused by send() since boot
+  unsigned long getDropCount();
+  // Number of chunks refused by the stack since boot
+  unsigned long getCongestionCount();
+
+protected:
+  // Hands one chunk to the stack, false when it is congested and the chunk must be retried
+  virtual bool transmit(const uint8_t *data, size_t length) = 0;
+
+private:
+  struct Staged {
+    char data[OutboundQueue::MAX_MESSAGE_SIZE];
+    size_t length;
+    OutboundQueue::Policy policy;
+    OutboundQueue::Encoding encoding;
+  };
+
+  SpscQueue<Staged, STAGING_CAPACITY> _staged;
+  std::atomic<unsigned long> _refusedCount{0};
+  OutboundQueue _queue;
+  // Bytes of the oldest message (marker included) already sent
+  size_t _frontOffset = 0;
+  size_t _chunkSize = DEFAULT_MTU - ATT_HEADER_SIZE;
+  unsigned long _congestionCount = 0;
+
+  bool stage(const char *data, size_t length, OutboundQueue::Policy policy, OutboundQueue::Encoding encoding);
+  // Moves the staged messages into the queue, oldest first, up to the first reply it
+  // has no room for
+  void unstage();
+  size_t fillChunk(uint8_t *chunk, size_t &messagesDone, size_t &offset);
+};
@@ -0,0 +1,69 @@
+#include "OutboundQueue.h"
+#include <cstring>
+
+bool OutboundQueue::push(const char *data, size_t length, Policy policy, Encoding encoding) {
+  if (length > MAX_MESSAGE_SIZE || (_count == CAPACITY && !evictOldestDroppable())) {
+    _dropCount++;
+    return false;
+  }
+
+  Slot &slot = at(_count);
+  memcpy(slot.data, data, length);
+  slot.length = length;
+  slot.policy = policy;
+  slot.encoding = encoding;
+  _count++;
+  if (_count > _maxDepth) {
+    _maxDepth = _count;
+  }
+  return true;
+}
+
+void OutboundQueue::pop() {
+  if (_count == 0) {
+    return;
+  }
+  _front = (_front + 1) % CAPACITY;
+  _count--;
+  _frontHeld = false;
+}
+
+bool OutboundQueue::canPush() const {
+  if (_count < CAPACITY) {
+    return true;
+  }
+  for (size_t i = _frontHeld ? 1 : 0; i < _count; i++) {
+    if (at(i).policy == DROP_OLDEST) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void OutboundQueue::clear() {
+  _front = 0;
+  _count = 0;
+  _frontHeld = false;
+}
+
+const char *OutboundQueue::data(size_t index) const { return at(index).data; }
+
+size_t OutboundQueue::length(size_t index) const { return at(index).length; }
+
+OutboundQueue::Encoding OutboundQueue::encoding(size_t index) const { return at(index).encoding; }
+
+bool OutboundQueue::evictOldestDroppable() {
+  for (size_t i = _frontHeld ? 1 : 0; i < _count; i++) {
+    if (at(i).policy != DROP_OLDEST) {
+      continue;
+    }
+    // Shift the younger messages down over the evicted one
+    for (size_t j = i; j + 1 < _count; j++) {
+      at(j) = at(j + 1);
+    }
+    _count--;
+    _dropCount++;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+
+// Bounded FIFO of outgoing messages, stored in place: pushing never allocates.
+// When the queue is full, a DROP_OLDEST message (telemetry, superseded by the next one)
+// is evicted to make room. NEVER_DROP messages (command replies) are never evicted:
+// pushing into a queue full of them fails and the caller is told.
+class OutboundQueue {
+public:
+  enum Policy { DROP_OLDEST, NEVER_DROP };
+  // TEXT messages end with the "\n" marker, BINARY frames go out alone and unmarked
+  enum Encoding { TEXT, BINARY };
+
+  static constexpr size_t CAPACITY = 8;
+  static constexpr size_t MAX_MESSAGE_SIZE = 128;
+
+  // False when the message was dropped: too long, or no room left for it
+  bool push(const char *data, size_t length, Policy policy, Encoding encoding = TEXT);
+  void pop();
+  // True when a push would not be refused for lack of room, if need be by evicting a
+  // DROP_OLDEST message
+  bool canPush() const;
+  void clear();
+
+  size_t size() const { return _count; }
+  bool empty() const { return _count == 0; }
+  // index-th message from the oldest one
+  const char *data(size_t index) const;
+  size_t length(size_t index) const;
+  Encoding encoding(size_t index) const;
+
+  // The oldest message is partly sent: it is never evicted until popped
+  void holdFront(bool held) { _frontHeld = held; }
+
+  // Messages evicted or refused since boot
+  unsigned long getDropCount() const { return _dropCount; }
+  // Deepest the queue has been since boot
+  size_t getMaxDepth() const { return _maxDepth; }
+
+private:
+  struct Slot {
+    char data[MAX_MESSAGE_SIZE];
+    size_t length;
+    Policy policy;
+    Encoding encoding;
+  };
+
+  Slot _slots[CAPACITY];
+  size_t _front = 0;
+  size_t _count = 0;
+  bool _frontHeld = false;
+  unsigned long _dropCount = 0;
+  size_t _maxDepth = 0;
+
+  Slot &at(size_t index) { return _slots[(_front + index) % CAPACITY]; }
+  const Slot &at(size_t index) const { return _slots[(_front + index) % CAPACITY]; }
+  bool evictOldestDroppable();
+};
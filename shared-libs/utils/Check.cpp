@@ -1,7 +1,8 @@
 #include "Check.h"
 #include <cctype>
+#include <charconv>
 
-bool isNumeric(const std::string &str) {
+bool isNumeric(std::string_view str) {
   if (str.empty())
     return false;
 
@@ -14,7 +15,7 @@ bool isNumeric(const std::string &str) {
   return true;
 }
 
-bool isAlphaNumericSentence(const std::string &str) {
+bool isAlphaNumericSentence(std::string_view str) {
   if (str.empty())
     return false;
 
@@ -26,22 +27,25 @@ bool isAlphaNumericSentence(const std::string &str) {
   return true;
 }
 
-bool startsWith(const std::string &s, const char *prefix) {
-  const size_t prefixLen = std::strlen(prefix);
-  return s.size() >= prefixLen && s.compare(0, prefixLen, prefix) == 0;
-}
-
-bool isStrictPositiveInt(const std::string &s) {
-  if (!isNumeric(s))
-    return false;
+bool startsWith(std::string_view s, std::string_view prefix) { return s.substr(0, prefix.size()) == prefix; }
 
-  long long value = 0;
-  for (unsigned char c : s) {
-    value = value * 10 + (c - '0');
-    if (value > 2147483647LL) {
-      return false;
-    }
+ParseStatus parseInt(std::string_view text, int min, int max, int &value) {
+  if (text.empty()) {
+    return ParseStatus::MISSING;
+  }
+  if (text.front() == '-' && min >= 0) {
+    return ParseStatus::NOT_A_NUMBER;
   }
 
-  return value >= 0;
-}
\ No newline at end of file
+  int parsed = 0;
+  const char *end = text.data() + text.size();
+  const std::from_chars_result result = std::from_chars(text.data(), end, parsed);
+  if (result.ec != std::errc() || result.ptr != end) {
+    return ParseStatus::NOT_A_NUMBER;
+  }
+  if (parsed < min || parsed > max) {
+    return ParseStatus::OUT_OF_RANGE;
+  }
+  value = parsed;
+  return ParseStatus::OK;
+}
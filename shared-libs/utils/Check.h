@@ -2,8 +2,16 @@
 
 #include <cstring>
 #include <string>
+#include <string_view>
 
-bool isNumeric(const std::string &str);
-bool isAlphaNumericSentence(const std::string &str);
-bool startsWith(const std::string &s, const char *prefix);
-bool isStrictPositiveInt(const std::string &s);
\ No newline at end of file
+bool isNumeric(std::string_view str);
+bool isAlphaNumericSentence(std::string_view str);
+bool startsWith(std::string_view s, std::string_view prefix);
+
+// Ordered by precedence: a command reports the highest status among its fields
+enum class ParseStatus { OK, OUT_OF_RANGE, NOT_A_NUMBER, MISSING };
+
+// Whole text as a decimal int within [min, max], in a single from_chars pass. Digits
+// only: no blank, no '+', and no '-' unless min is negative. A value past int is
+// NOT_A_NUMBER, like any other malformed input; an empty text is MISSING.
+ParseStatus parseInt(std::string_view text, int min, int max, int &value);
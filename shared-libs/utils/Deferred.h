@@ -0,0 +1,29 @@
+#pragma once
+
+#include <new>
+#include <utility>
+
+// Storage for one T inside its owner, constructed later in place: once the hardware and
+// the settings it reads are ready (Program::setup), not at static initialization and not
+// on the heap. The object is never destroyed, the components live until the next reset.
+template <typename T> class Deferred {
+public:
+  Deferred() = default;
+  Deferred(const Deferred &) = delete;
+  Deferred &operator=(const Deferred &) = delete;
+
+  // Constructs the object, once
+  template <typename... Args> T &emplace(Args &&...args) {
+    _object = new (_storage) T(std::forward<Args>(args)...);
+    return *_object;
+  }
+
+  // Null until emplace()
+  T *get() const { return _object; }
+  T *operator->() const { return _object; }
+  T &operator*() const { return *_object; }
+
+private:
+  alignas(T) unsigned char _storage[sizeof(T)];
+  T *_object = nullptr;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Builds a text message in a buffer of its own, on the stack: appending never allocates.
+// Integers are written like std::to_string. Text past the N bytes is cut and reported by
+// overflowed(); the content always stays NUL-terminated.
+template <size_t N> class FixedWriter {
+public:
+  static constexpr size_t CAPACITY = N;
+
+  FixedWriter &append(std::string_view text) {
+    for (char c : text) {
+      append(c);
+    }
+    return *this;
+  }
+
+  FixedWriter &append(char c) {
+    if (_length < N) {
+      _buffer[_length++] = c;
+      _buffer[_length] = '\0';
+    } else {
+      _overflowed = true;
+    }
+    return *this;
+  }
+
+  FixedWriter &appendInt(long long value) {
+    if (value < 0) {
+      append('-');
+    }
+    return appendDigits(magnitude(value), 1);
+  }
+
+  // scaled / 10^decimals with exactly that many decimals: (235, 1) gives "23.5", (-5, 1) "-0.5"
+  FixedWriter &appendFixed(long long scaled, unsigned decimals) {
+    unsigned long long divisor = 1;
+    for (unsigned i = 0; i < decimals; i++) {
+      divisor *= 10;
+    }
+    const unsigned long long value = magnitude(scaled);
+    if (scaled < 0) {
+      append('-');
+    }
+    appendDigits(value / divisor, 1);
+    if (decimals > 0) {
+      append('.');
+      appendDigits(value % divisor, decimals);
+    }
+    return *this;
+  }
+
+  // The values separated by separator ("1,2,3")
+  template <typename T> FixedWriter &appendInts(const T *values, size_t count, char separator = ',') {
+    for (size_t i = 0; i < count; i++) {
+      if (i > 0) {
+        append(separator);
+      }
+      appendInt(values[i]);
+    }
+    return *this;
+  }
+
+  const char *data() const { return _buffer; }
+  size_t size() const { return _length; }
+  std::string_view view() const { return std::string_view(_buffer, _length); }
+  bool overflowed() const { return _overflowed; }
+
+  void clear() {
+    _length = 0;
+    _buffer[0] = '\0';
+    _overflowed = false;
+  }
+
+private:
+  char _buffer[N + 1] = {};
+  size_t _length = 0;
+  bool _overflowed = false;
+
+  // Safe for the most negative value, which has no positive counterpart
+  static unsigned long long magnitude(long long value) {
+    return value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+  }
+
+  // value in decimal, left-padded with zeros to minDigits
+  FixedWriter &appendDigits(unsigned long long value, unsigned minDigits) {
+    char digits[20];
+    unsigned count = 0;
+    do {
+      digits[count++] = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value > 0 && count < sizeof(digits));
+    while (count < minDigits && count < sizeof(digits)) {
+      digits[count++] = '0';
+    }
+    while (count > 0) {
+      append(digits[--count]);
+    }
+    return *this;
+  }
+};
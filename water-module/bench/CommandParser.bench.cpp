@@ -0,0 +1,126 @@
+// Host micro-benchmark: TankCfgProtocol command handling against the extractValue/stoi
+// parser it replaced, in commands per second.
+// Not part of any PlatformIO env, build and run it by hand from water-module/:
+//   g++ -std=gnu++17 -O2 -Ilib/protocol -Ilib/settings -I../shared-libs/protocol -I../shared-libs/settings
+//     -I../shared-libs/utils bench/CommandParser.bench.cpp lib/protocol/TankCfgProtocol.cpp
+//     lib/settings/TankSettings.cpp lib/settings/TankGeometry.cpp ../shared-libs/protocol/CommandFields.cpp
+//     ../shared-libs/utils/Check.cpp -o .pio/command-bench
+//   .pio/command-bench
+#include "Check.h"
+#include "TankCfgProtocol.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Keeps the last saved values in place, so the store itself costs next to nothing
+class NullSettings : public Settings {
+public:
+  int get(const char *, const int defaultValue) override { return defaultValue; }
+  void save(const char *, const int value) override { _last = value; }
+  std::string get(const char *, const std::string defaultValue) override { return defaultValue; }
+  void save(const char *, const char *) override {}
+
+private:
+  int _last = 0;
+};
+
+// The previous CFG: path: a substr per field, a scan per check, then std::stoi
+class CopyingCfgParser {
+public:
+  // Copies the command, as the std::string parameter of the old handler did
+  void handle(std::string_view rx, CommandReply &reply) { reply.append(parse(std::string(rx))); }
+
+  long checksum() const { return _checksum; }
+
+private:
+  long _checksum = 0;
+
+  std::string parse(std::string rx) {
+    if (rx.compare(0, 4, "CFG:") != 0) {
+      return "ERR_UNKNOWN_CMD";
+    }
+    std::string vStr = extractValue(rx, "V");
+    std::string hStr = extractValue(rx, "H");
+    if (vStr.empty() || hStr.empty()) {
+      return "ERR_CFG_FMT";
+    }
+    if (!isStrictPositiveInt(vStr) || !isStrictPositiveInt(hStr)) {
+      return "ERR_CFG_NUM";
+    }
+    const int v = std::stoi(vStr);
+    const int h = std::stoi(hStr);
+    if (v <= 0 || v > 5000 || h <= 0 || h > 10000) {
+      return "ERR_CFG_RANGE";
+    }
+    _checksum += v + h;
+    return "OK";
+  }
+
+  static std::string extractValue(const std::string &cmd, const char *key) {
+    const std::string needle = std::string(key) + "=";
+    const size_t pos = cmd.find(needle);
+    if (pos == std::string::npos)
+      return "";
+    const size_t start = pos + needle.length();
+    const size_t end = cmd.find(';', start);
+    if (end == std::string::npos)
+      return cmd.substr(start);
+    return cmd.substr(start, end - start);
+  }
+
+  static bool isStrictPositiveInt(const std::string &s) {
+    if (!isNumeric(s))
+      return false;
+    long long value = 0;
+    for (unsigned char c : s) {
+      value = value * 10 + (c - '0');
+      if (value > 2147483647LL) {
+        return false;
+      }
+    }
+    return value >= 0;
+  }
+};
+
+// A mix of valid writes and the usual mistakes, as received from the BLE stack
+static const std::string COMMANDS[] = {"CFG:V=150;H=500", "CFG:V=1200;H=9500", "CFG:H=480;V=abc", "CFG:V=120",
+                                       "CFG:V=999999;H=100"};
+static constexpr int ROUNDS = 400000;
+
+template <typename Handler> static double commandsPerSecond(Handler &handler, size_t &okCount) {
+  const auto start = std::chrono::steady_clock::now();
+  CommandReply reply;
+  for (int round = 0; round < ROUNDS; round++) {
+    for (const std::string &command : COMMANDS) {
+      reply.clear();
+      handler.handle(command, reply);
+      okCount += reply.view() == "OK";
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return ROUNDS * (sizeof(COMMANDS) / sizeof(COMMANDS[0])) / std::chrono::duration<double>(elapsed).count();
+}
+
+int main() {
+  NullSettings settings;
+  TankSettings tankSettings(&settings, "grey");
+  TankGeometry geometry;
+  TankCfgProtocol protocol(&tankSettings, &geometry);
+  CopyingCfgParser copying;
+
+  size_t copyingOk = 0;
+  size_t viewOk = 0;
+  const double copyingRate = commandsPerSecond(copying, copyingOk);
+  const double viewRate = commandsPerSecond(protocol, viewOk);
+  if (copyingOk != viewOk) {
+    std::printf("parsers disagree: %zu vs %zu OK\n", copyingOk, viewOk);
+    return 1;
+  }
+
+  std::printf("%12s %16s\n", "parser", "commands/s");
+  std::printf("%12s %16.0f\n", "copying", copyingRate);
+  std::printf("%12s %16.0f\n", "string_view", viewRate);
+  std::printf("speedup %.1fx (checksum %ld)\n", viewRate / copyingRate, copying.checksum());
+  return 0;
+}
@@ -0,0 +1,105 @@
+// Host micro-benchmark: the tank filters as InputSignal stages (one heap object and one
+// virtual call per stage) against the same filters in a FilterPipeline.
+// Not part of any PlatformIO env, build and run it by hand from water-module/:
+//   g++ -std=gnu++11 -O2 -Ilib/filters -Ilib/sensors bench/FilterPipeline.bench.cpp lib/filters/*.cpp
+//     lib/sensors/InputSignal.cpp -o .pio/pipeline-bench
+//   .pio/pipeline-bench
+#include "EmaFilter.h"
+#include "FilterPipeline.h"
+#include "FixedMedianFilter.h"
+#include "InputSignal.h"
+#include "MedianFilter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Heap bytes requested since boot, to measure what each setup allocates
+static size_t heapBytes = 0;
+
+// GCC pairs the inlined malloc() below with the free() of operator delete
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void *operator new(std::size_t size) {
+  heapBytes += size;
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+#pragma GCC diagnostic pop
+
+// Replays recorded distances (mm) like the ultrasonic sensor would
+class ReplaySensor : public Sensor {
+public:
+  explicit ReplaySensor(const std::vector<int> &samples) : _samples(samples) {}
+  int read() override { return _samples[_index++ % _samples.size()]; }
+  int maxRange() override { return 4500; }
+
+private:
+  const std::vector<int> &_samples;
+  size_t _index = 0;
+};
+
+static std::vector<int> makeSamples(size_t count) {
+  std::vector<int> samples(count);
+  unsigned int seed = 42;
+  for (size_t i = 0; i < count; i++) {
+    seed = seed * 1103515245 + 12345;
+    const int noise = static_cast<int>((seed >> 16) % 21) - 10;
+    const bool spike = (seed >> 8) % 50 == 0;
+    samples[i] = 800 - static_cast<int>(i / 100) + noise + (spike ? 400 : 0);
+  }
+  return samples;
+}
+
+// Nanoseconds per sample; checksum keeps the reads from being optimized away
+static double measure(InputSignal &input, size_t count, long &checksum) {
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    checksum += input.read();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / count;
+}
+
+int main() {
+  const std::vector<int> samples = makeSamples(200000);
+
+  ReplaySensor stagesSensor(samples);
+  size_t heapBefore = heapBytes;
+  InputSignal stages(&stagesSensor);
+  stages.addFilter(new MedianFilter(9));
+  stages.addFilter(new EmaFilter(1, 2));
+  const size_t stagesHeap = heapBytes - heapBefore;
+
+  ReplaySensor pipelineSensor(samples);
+  heapBefore = heapBytes;
+  InputSignal pipelined(&pipelineSensor);
+  using TankFilter = FilterPipeline<FixedMedianFilter<9>, EmaFilter>;
+  pipelined.addFilter(new TankFilter(FixedMedianFilter<9>(), EmaFilter(1, 2)));
+  const size_t pipelineHeap = heapBytes - heapBefore;
+
+  long stagesChecksum = 0;
+  long pipelineChecksum = 0;
+  const double stagesNs = measure(stages, samples.size(), stagesChecksum);
+  const double pipelineNs = measure(pipelined, samples.size(), pipelineChecksum);
+  if (stagesChecksum != pipelineChecksum) {
+    std::printf("outputs differ\n");
+    return 1;
+  }
+
+  std::printf("%-24s %10s %12s\n", "median(9) + ema(1/2)", "ns/sample", "heap bytes");
+  std::printf("%-24s %10.1f %12zu\n", "InputSignal stages", stagesNs, stagesHeap);
+  std::printf("%-24s %10.1f %12zu\n", "FilterPipeline", pipelineNs, pipelineHeap);
+  std::printf("pipeline object: %zu bytes, no allocation per sample in either setup\n",
+              sizeof(TankFilter));
+  return 0;
+}
@@ -0,0 +1,83 @@
+// Host micro-benchmark: streaming MedianFilter against the copy-and-sort filter it replaced.
+// Not part of any PlatformIO env, build and run it by hand from water-module/:
+//   g++ -std=gnu++11 -O2 -Ilib/filters bench/MedianFilter.bench.cpp lib/filters/MedianFilter.cpp -o .pio/median-bench
+//   .pio/median-bench
+#include "MedianFilter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// The previous implementation: sorts a copy of the window on every sample
+class SortingMedianFilter : public Filter {
+public:
+  SortingMedianFilter(int windowSize) : _windowSize(windowSize), _bufferIndex(-1) {
+    _dataBuffer.resize(_windowSize, 0);
+    _tempBuffer.reserve(_windowSize);
+  }
+
+  int apply(int newValue) override {
+    if (_bufferIndex == -1) {
+      for (int i = 0; i < _windowSize; i++)
+        _dataBuffer[i] = newValue;
+      _bufferIndex = 0;
+      return newValue;
+    }
+
+    _dataBuffer[_bufferIndex] = newValue;
+    _bufferIndex = (_bufferIndex + 1) % _windowSize;
+    _tempBuffer = _dataBuffer;
+    std::sort(_tempBuffer.begin(), _tempBuffer.end());
+    return _tempBuffer[_windowSize / 2];
+  }
+
+private:
+  int _windowSize;
+  int _bufferIndex;
+  std::vector<int> _dataBuffer;
+  std::vector<int> _tempBuffer;
+};
+
+// Noisy tank distances (mm): a slow level drift plus sensor noise and some spikes
+static std::vector<int> makeSamples(size_t count) {
+  std::vector<int> samples(count);
+  unsigned int seed = 42;
+  for (size_t i = 0; i < count; i++) {
+    seed = seed * 1103515245 + 12345;
+    const int noise = static_cast<int>((seed >> 16) % 21) - 10;
+    const bool spike = (seed >> 8) % 50 == 0;
+    samples[i] = 800 - static_cast<int>(i / 100) + noise + (spike ? 400 : 0);
+  }
+  return samples;
+}
+
+// Nanoseconds per sample; checksum keeps the calls from being optimized away
+static double measure(Filter &filter, const std::vector<int> &samples, long &checksum) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int sample : samples) {
+    checksum += filter.apply(sample);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / samples.size();
+}
+
+int main() {
+  const std::vector<int> samples = makeSamples(200000);
+  const int windowSizes[] = {5, 9, 15, 25, 51, 75, 101};
+
+  std::printf("%8s %14s %14s %8s\n", "window", "sort ns/smp", "stream ns/smp", "speedup");
+  for (int windowSize : windowSizes) {
+    SortingMedianFilter sorting(windowSize);
+    MedianFilter streaming(windowSize);
+    long sortingChecksum = 0;
+    long streamingChecksum = 0;
+    const double sortingNs = measure(sorting, samples, sortingChecksum);
+    const double streamingNs = measure(streaming, samples, streamingChecksum);
+    if (sortingChecksum != streamingChecksum) {
+      std::printf("window %d: outputs differ\n", windowSize);
+      return 1;
+    }
+    std::printf("%8d %14.1f %14.1f %7.1fx\n", windowSize, sortingNs, streamingNs, sortingNs / streamingNs);
+  }
+  return 0;
+}
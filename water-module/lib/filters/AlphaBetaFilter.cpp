@@ -0,0 +1,30 @@
+#include "AlphaBetaFilter.h"
+
+AlphaBetaFilter::AlphaBetaFilter(int alphaNumerator, int alphaDenominator, int betaNumerator, int betaDenominator,
+                                 int rateSmoothingShift)
+    : _alphaNumerator(alphaNumerator), _alphaDenominator(alphaDenominator), _betaNumerator(betaNumerator),
+      _betaDenominator(betaDenominator), _primed(false), _position(0), _rate(0), _smoothedRate(rateSmoothingShift),
+      _publishedRate(0) {}
+
+int AlphaBetaFilter::apply(int newValue) {
+  const int32_t measured = static_cast<int32_t>(newValue) * (1 << POSITION_BITS);
+  if (!_primed) {
+    _position = measured;
+    _rate = 0;
+    _primed = true;
+  } else {
+    // Predict from the rate (Q16 to Q8, rounded), then correct both with the residual
+    const int toPosition = RATE_BITS - POSITION_BITS;
+    const int32_t predicted = _position + ((_rate + (1 << (toPosition - 1))) >> toPosition);
+    const int64_t residual = measured - predicted;
+    _position = predicted + static_cast<int32_t>(residual * _alphaNumerator / _alphaDenominator);
+    _rate += static_cast<int32_t>(residual * (1 << toPosition) * _betaNumerator / _betaDenominator);
+  }
+  _publishedRate = _smoothedRate.apply(_rate);
+  return (_position + (1 << (POSITION_BITS - 1))) >> POSITION_BITS;
+}
+
+int AlphaBetaFilter::getRate(int samplePeriodMs) const {
+  // Q16 mm per sample -> tenths of mm per minute
+  return static_cast<int>(static_cast<int64_t>(_publishedRate) * 10 * 60000 / samplePeriodMs / (1 << RATE_BITS));
+}
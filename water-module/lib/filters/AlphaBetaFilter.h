@@ -0,0 +1,38 @@
+#pragma once
+#include "EmaFilter.h"
+#include "Filter.h"
+#include <stdint.h>
+
+// Alpha-beta tracker of a slowly moving level: each sample corrects a prediction made
+// from the previous position and rate, instead of averaging past samples. A filling or
+// draining tank is followed without the lag of a median + EMA chain, and the rate comes
+// for free. Spikes are not rejected: put a median stage in front.
+// Fixed point like EmaFilter: position in Q8 mm, rate in Q16 mm per sample.
+class AlphaBetaFilter : public Filter {
+public:
+  static constexpr int POSITION_BITS = 8;
+  static constexpr int RATE_BITS = 16;
+
+  // alpha corrects the position, beta the rate (alpha = alphaNumerator / alphaDenominator).
+  // rateSmoothingShift averages the published rate over about 2^shift samples.
+  AlphaBetaFilter(int alphaNumerator, int alphaDenominator, int betaNumerator, int betaDenominator,
+                  int rateSmoothingShift);
+
+  int apply(int newValue) override;
+
+  // Change of the filtered value in tenths of mm per minute, positive when it grows,
+  // for samples samplePeriodMs apart
+  int getRate(int samplePeriodMs) const;
+
+private:
+  int32_t _alphaNumerator;
+  int32_t _alphaDenominator;
+  int32_t _betaNumerator;
+  int32_t _betaDenominator;
+  bool _primed;
+  int32_t _position;
+  int32_t _rate;
+  // Averages _rate for display, the tracker itself uses the raw rate
+  EmaFilter _smoothedRate;
+  int _publishedRate;
+};
@@ -1,15 +1,27 @@
 #include "EmaFilter.h"
 #include <algorithm>
 
-EmaFilter::EmaFilter(float alpha) : _alpha(alpha), _lastValue(0) {}
+EmaFilter::EmaFilter(int shift)
+    : _shift(std::min(std::max(shift, 0), MAX_SHIFT)), _numerator(1), _denominator(1), _primed(false), _average(0) {}
+
+EmaFilter::EmaFilter(int numerator, int denominator)
+    : _shift(-1), _numerator(1), _denominator(std::max(denominator, 1)), _primed(false), _average(0) {
+  _numerator = std::min(std::max<int32_t>(numerator, 1), _denominator);
+}
 
 int EmaFilter::apply(int newValue) {
-  if (_lastValue == 0) {
-    _lastValue = newValue;
+  const int32_t sample = static_cast<int32_t>(newValue) * (1 << FRACTION_BITS);
+  if (!_primed) {
+    _average = sample;
+    _primed = true;
   } else {
-    float result = (_alpha * newValue) + ((1.0 - _alpha) * _lastValue);
-    // Add 0.5 to round to the nearest integer
-    _lastValue = (int)(result + 0.5);
+    const int32_t delta = sample - _average;
+    if (_shift >= 0) {
+      _average += delta >> _shift;
+    } else {
+      _average += static_cast<int32_t>(static_cast<int64_t>(delta) * _numerator / _denominator);
+    }
   }
-  return _lastValue;
-}
\ No newline at end of file
+  // Round to the nearest integer, halves up
+  return (_average + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS;
+}
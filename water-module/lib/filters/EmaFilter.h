@@ -1,15 +1,32 @@
 #pragma once
 #include "Filter.h"
 #include <stdint.h>
-#include <vector>
 
+// Exponential moving average in fixed point: the average is kept with FRACTION_BITS
+// fractional bits, so a step smaller than 1 still accumulates, and no float or double
+// math runs per sample. The first sample primes the average.
+// Alpha is 1 / 2^shift, or numerator / denominator. Arguments out of range are clamped:
+// shift to [0, MAX_SHIFT], denominator to at least 1, numerator to [1, denominator].
 class EmaFilter : public Filter {
 public:
-  EmaFilter(float alpha);
+  static constexpr int FRACTION_BITS = 8;
+  // Widest shift of a 32-bit average
+  static constexpr int MAX_SHIFT = 30;
+
+  explicit EmaFilter(int shift);
+  EmaFilter(int numerator, int denominator);
+  // Alpha is no longer a float: EmaFilter(0.5) would silently convert to a shift of 0
+  EmaFilter(float alpha) = delete;
+  EmaFilter(double alpha) = delete;
 
   int apply(int newValue) override;
 
 private:
-  int _lastValue;
-  float _alpha;
+  // Alpha as a shift when >= 0, else as numerator / denominator
+  int _shift;
+  int32_t _numerator;
+  int32_t _denominator;
+  bool _primed;
+  // Average in Q(FRACTION_BITS)
+  int32_t _average;
 };
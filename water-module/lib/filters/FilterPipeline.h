@@ -0,0 +1,49 @@
+#pragma once
+#include "Filter.h"
+
+// Filter stages chained at compile time, for a fixed setup (InputSignal stays for filters
+// chosen at runtime). Stages are stored by value, so the pipeline needs no heap beyond
+// what a stage allocates itself (prefer FixedMedianFilter over MedianFilter), and stages
+// are called without virtual dispatch, so the compiler can inline them. Only the
+// pipeline itself is a Filter, to plug it into an InputSignal as a single stage:
+//   FilterPipeline<FixedMedianFilter<9>, EmaFilter> tankFilter(FixedMedianFilter<9>(), EmaFilter(1, 2));
+template <typename... Stages> class FilterChain;
+
+// Selects a stage by its type in FilterChain::stage()
+template <typename Stage> struct StageTag {};
+
+template <> class FilterChain<> {
+public:
+  int apply(int value) { return value; }
+};
+
+template <typename First, typename... Rest> class FilterChain<First, Rest...> {
+public:
+  FilterChain() = default;
+  FilterChain(const First &first, const Rest &...rest) : _first(first), _rest(rest...) {}
+
+  // The qualified call skips the virtual dispatch of Filter::apply
+  int apply(int value) { return _rest.apply(_first.First::apply(value)); }
+
+  // The non-template overload wins when Stage is First, otherwise the search goes on
+  First &stage(StageTag<First>) { return _first; }
+  template <typename Stage> Stage &stage(StageTag<Stage> tag) { return _rest.stage(tag); }
+
+private:
+  First _first;
+  FilterChain<Rest...> _rest;
+};
+
+template <typename... Stages> class FilterPipeline : public Filter {
+public:
+  FilterPipeline() = default;
+  explicit FilterPipeline(const Stages &...stages) : _stages(stages...) {}
+
+  int apply(int newValue) override { return _stages.apply(newValue); }
+
+  // First stage of that type, to read what it tracks (e.g. the AlphaBetaFilter rate)
+  template <typename Stage> Stage &stage() { return _stages.stage(StageTag<Stage>()); }
+
+private:
+  FilterChain<Stages...> _stages;
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include "Filter.h"
+#include "MedianFilter.h"
+
+// MedianFilter with the window size fixed at compile time: the window lives in the
+// object instead of the heap, for FilterPipeline stages. Same output as MedianFilter.
+template <int WindowSize> class FixedMedianFilter : public Filter {
+  static_assert(WindowSize > 0, "Median window must hold at least one sample");
+
+public:
+  int apply(int newValue) override {
+    if (_bufferIndex == -1) {
+      for (int i = 0; i < WindowSize; i++) {
+        _dataBuffer[i] = newValue;
+        _sortedBuffer[i] = newValue;
+      }
+      _bufferIndex = 0;
+      return newValue;
+    }
+
+    MedianFilter::replaceSorted(_sortedBuffer, WindowSize, _dataBuffer[_bufferIndex], newValue);
+    _dataBuffer[_bufferIndex] = newValue;
+    _bufferIndex = (_bufferIndex + 1) % WindowSize;
+    return _sortedBuffer[WindowSize / 2];
+  }
+
+private:
+  int _bufferIndex = -1;
+  int _dataBuffer[WindowSize] = {};
+  int _sortedBuffer[WindowSize] = {};
+};
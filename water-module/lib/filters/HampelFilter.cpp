@@ -0,0 +1,83 @@
+#include "HampelFilter.h"
+#include <algorithm>
+#include <stdlib.h>
+
+// 3 x 1.4826 (MAD to standard deviation of a normal distribution), as a ratio
+static constexpr int THRESHOLD_NUMERATOR = 89;
+static constexpr int THRESHOLD_DENOMINATOR = 20;
+// Motion mode starts when the MAD exceeds this many times its calm baseline
+static constexpr int MOTION_FACTOR = 3;
+
+// A window holds at least the new sample, and no more than the history keeps
+static int clampWindow(int size) { return std::min(std::max(size, 1), HampelFilter::MAX_WINDOW); }
+
+HampelFilter::HampelFilter(int windowSize, int motionWindowSize, int minDeviation)
+    : _windowSize(clampWindow(windowSize)), _motionWindowSize(clampWindow(motionWindowSize)),
+      _minDeviation(minDeviation), _calmDeviation(5) {}
+
+int HampelFilter::apply(int newValue) {
+  if (!_primed) {
+    std::fill(_history, _history + MAX_WINDOW, newValue);
+    _primed = true;
+    return newValue;
+  }
+
+  int median = 0;
+  int deviation = 0;
+  spread(_inMotion ? _motionWindowSize : _windowSize, median, deviation);
+
+  const long limit = static_cast<long>(deviation) * THRESHOLD_NUMERATOR / THRESHOLD_DENOMINATOR;
+  const int distance = abs(newValue - median);
+  const bool rejected = distance > _minDeviation && distance > limit;
+  if (rejected) {
+    _rejectedCount++;
+    if (_inMotion) {
+      _rejectedInMotionCount++;
+    }
+  }
+
+  _history[_next] = newValue;
+  _next = (_next + 1) % MAX_WINDOW;
+  updateMotion();
+
+  return rejected ? median : newValue;
+}
+
+void HampelFilter::spread(int size, int &median, int &deviation) const {
+  int sorted[MAX_WINDOW] = {};
+  for (int i = 0; i < size; i++) {
+    sorted[i] = _history[(_next + MAX_WINDOW - 1 - i) % MAX_WINDOW];
+  }
+  std::sort(sorted, sorted + size);
+  median = sorted[size / 2];
+
+  for (int i = 0; i < size; i++) {
+    sorted[i] = abs(sorted[i] - median);
+  }
+  std::sort(sorted, sorted + size);
+  deviation = sorted[size / 2];
+}
+
+// Compares the MAD of the narrow window, new sample included, with its calm baseline
+void HampelFilter::updateMotion() {
+  int median = 0;
+  int deviation = 0;
+  spread(_windowSize, median, deviation);
+  const bool agitated = deviation * 2 >= _minDeviation && deviation > MOTION_FACTOR * _calmBaseline;
+
+  if (!_inMotion) {
+    if (agitated) {
+      _inMotion = true;
+      _motionCount++;
+      _calmSamples = 0;
+    } else {
+      _calmBaseline = _calmDeviation.apply(deviation);
+    }
+    return;
+  }
+
+  _calmSamples = agitated ? 0 : _calmSamples + 1;
+  if (_calmSamples >= _motionWindowSize) {
+    _inMotion = false;
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "EmaFilter.h"
+#include "Filter.h"
+
+// Hampel outlier stage: a sample further from the median of the recent samples than 3
+// estimated standard deviations (1.4826 x their median absolute deviation, MAD) is
+// replaced by that median. Rejected samples still enter the window, so a real level
+// jump is accepted once it holds for half the window.
+// Motion mode: when the MAD jumps above its calm baseline (sloshing while driving), the
+// window widens to motionWindowSize so bursts of spikes stay a minority; it narrows
+// again after motionWindowSize calm samples.
+// Put it first in the chain, on the raw samples.
+class HampelFilter : public Filter {
+public:
+  static constexpr int MAX_WINDOW = 21;
+
+  // Samples closer than minDeviation (mm) to the median are always kept, for steady
+  // readings whose MAD is 0
+  HampelFilter(int windowSize, int motionWindowSize, int minDeviation);
+
+  int apply(int newValue) override;
+
+  bool inMotion() const { return _inMotion; }
+  unsigned long getRejectedCount() const { return _rejectedCount; }
+  unsigned long getRejectedInMotionCount() const { return _rejectedInMotionCount; }
+  unsigned long getMotionCount() const { return _motionCount; }
+
+private:
+  int _windowSize;
+  int _motionWindowSize;
+  int _minDeviation;
+  bool _primed = false;
+  // Last MAX_WINDOW raw samples, _next being the oldest
+  int _history[MAX_WINDOW] = {};
+  int _next = 0;
+
+  bool _inMotion = false;
+  int _calmSamples = 0;
+  // Average MAD of the narrow window while calm
+  EmaFilter _calmDeviation;
+  int _calmBaseline = 0;
+
+  unsigned long _rejectedCount = 0;
+  unsigned long _rejectedInMotionCount = 0;
+  unsigned long _motionCount = 0;
+
+  // Median and MAD of the last size samples
+  void spread(int size, int &median, int &deviation) const;
+  void updateMotion();
+};
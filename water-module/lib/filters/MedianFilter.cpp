@@ -3,20 +3,37 @@
 
 MedianFilter::MedianFilter(int windowSize) : _windowSize(windowSize), _bufferIndex(-1) {
   _dataBuffer.resize(_windowSize, 0);
-  _tempBuffer.reserve(_windowSize);
+  _sortedBuffer.resize(_windowSize, 0);
 }
 
 int MedianFilter::apply(int newValue) {
   if (_bufferIndex == -1) {
-    for (int i = 0; i < _windowSize; i++)
+    for (int i = 0; i < _windowSize; i++) {
       _dataBuffer[i] = newValue;
+      _sortedBuffer[i] = newValue;
+    }
     _bufferIndex = 0;
     return newValue;
   }
 
+  replaceSorted(_sortedBuffer.data(), _windowSize, _dataBuffer[_bufferIndex], newValue);
   _dataBuffer[_bufferIndex] = newValue;
   _bufferIndex = (_bufferIndex + 1) % _windowSize;
-  _tempBuffer = _dataBuffer;
-  std::sort(_tempBuffer.begin(), _tempBuffer.end());
-  return _tempBuffer[_windowSize / 2];
-}
\ No newline at end of file
+  return _sortedBuffer[_windowSize / 2];
+}
+
+// Overwrites one occurrence of oldValue, found by binary search, then moves newValue
+// towards its place, shifting the values it passes by one slot.
+void MedianFilter::replaceSorted(int *sorted, int size, int oldValue, int newValue) {
+  int position = std::lower_bound(sorted, sorted + size, oldValue) - sorted;
+
+  while (position + 1 < size && sorted[position + 1] < newValue) {
+    sorted[position] = sorted[position + 1];
+    position++;
+  }
+  while (position > 0 && sorted[position - 1] > newValue) {
+    sorted[position] = sorted[position - 1];
+    position--;
+  }
+  sorted[position] = newValue;
+}
@@ -3,15 +3,23 @@
 #include <stdint.h>
 #include <vector>
 
+// Median of the last windowSize samples (the upper one for an even window), the window
+// starting filled with the first sample.
+// Keeps the window both in arrival order and sorted: each sample replaces the oldest one
+// in the sorted copy by shifting only the values between their two positions, instead of
+// sorting the whole window again. No allocation after construction.
 class MedianFilter : public Filter {
 public:
   MedianFilter(int windowSize);
 
   int apply(int newValue) override;
 
+  // Replaces one occurrence of oldValue with newValue in the sorted array, keeping it sorted
+  static void replaceSorted(int *sorted, int size, int oldValue, int newValue);
+
 private:
   int _windowSize;
   int _bufferIndex;
   std::vector<int> _dataBuffer;
-  std::vector<int> _tempBuffer;
+  std::vector<int> _sortedBuffer;
 };
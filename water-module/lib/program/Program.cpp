@@ -1,9 +1,9 @@
 #include "Program.h"
 #include "BleManager.h"
-#include "EmaFilter.h"
 #include "InputSignal.h"
 #include "Logger.h"
-#include "MedianFilter.h"
+#include "Os.h"
+#include "TankSettings.h"
 #include "TankValveListner.h"
 #include "UltrasonicSensor.h"
 #include "ValveSettings.h"
@@ -14,45 +14,122 @@
 #define DEEP_SLEEP_SECONDS 5
 #define ADVERTISE_SECONDS 5
 
+static constexpr const char *CLEAN_TANK_NAME = "clean_tank";
+static constexpr const char *GREY_TANK_NAME = "grey_tank";
+static constexpr const char *GREY_VALVE_NAME = "grey_valve";
+static_assert(TankSettings::fitsName(CLEAN_TANK_NAME) && TankSettings::fitsName(GREY_TANK_NAME),
+              "Tank name too long for its NVS keys");
+static_assert(ValveSettings::fitsName(GREY_VALVE_NAME), "Valve name too long for its NVS keys");
+
+// Task periods. Tank sampling is about one sensor sample per run (scales the fill rate);
+// the valve keeps its own 1 s countdown from the opening, checked at 10 Hz.
+static constexpr int TICK_MS = 110;
+static constexpr unsigned long COMMANDS_MS = 20;
+static constexpr unsigned long VALVE_MS = 100;
+static constexpr unsigned long SETTINGS_MS = 1000;
+
+// Radio task: log drain and sender step on the core of the NimBLE host, at the priority
+// of the loop task. Its stack covers a 512-byte chunk and the notify path.
+static constexpr unsigned long RADIO_MS = 20;
+static constexpr size_t RADIO_STACK_BYTES = 4096;
+static constexpr unsigned RADIO_PRIORITY = 1;
+
 void Program::setup(Stream &serial, Stream &serial1, Stream &serial2, int relayPin) {
-  _logger = new Logger(serial, Logger::INFO);
-  _logger->info("Starting water tank module...");
+  _logger.emplace(serial, Logger::INFO);
+  LOG_INFO(_logger, "Starting water tank module...");
 
-  _bleManager = new BleManager(_logger, _settings);
+  _bleManager.emplace(_logger.get(), _settings);
   _bleManager->setup("Water Tank", "0001");
 
-  _cleanTank = createNotifier("clean_tank", "0002", serial1, _logger);
-  _greyTank = createNotifier("grey_tank", "0003", serial2, _logger);
+  setupTank(_cleanTank, CLEAN_TANK_NAME, "0002", serial1);
+  setupTank(_greyTank, GREY_TANK_NAME, "0003", serial2);
 
-  _greyValve = new TankValveListner("grey_valve", "0004", relayPin, _settings);
-  _bleManager->addChannel(_greyValve);
+  _greyValve.emplace(GREY_VALVE_NAME, "0004", relayPin, _settings);
+  _bleManager->addChannel(_greyValve.get());
 
   _bleManager->start();
 
+  _scheduler.emplace(_clock, _logger.get());
+  _scheduler->every<Program, &Program::dispatchCommands>("commands", COMMANDS_MS, this);
+  _scheduler->every<Program, &Program::persistSettings>("settings", SETTINGS_MS, this);
+  _scheduler->every<Program, &Program::sampleTanks>("tanks", TICK_MS, this);
+  _scheduler->every<Program, &Program::checkValve>("valve", VALVE_MS, this);
+
   _startAt = millis();
-  _logger->info("Setup done. Waiting for connection...");
+  LOG_INFO(_logger, "Setup done. Waiting for connection...");
+  _logger->flush();
+
+  // From here on the logger output and the BLE stack belong to the radio task
+  if (!os::startTask("radio", &Program::radioTask, this, os::RADIO_CORE, RADIO_STACK_BYTES, RADIO_PRIORITY)) {
+    LOG_WARN(_logger, "No radio task, serviced from the loop");
+    _scheduler->every<Program, &Program::service>("service", RADIO_MS, this);
+  }
 }
 
+// The loop task, pinned to the control core, runs the control loops and the commands
 void Program::loop() {
-  if (_bleManager->isConnected()) {
-    _cleanTank->notify();
-    _greyTank->notify();
-    _greyValve->loop();
-    delay(110);
-  } else if (millis() - _startAt > (ADVERTISE_SECONDS * 1000)) {
-    _logger->info("Timeout -> Deep Sleep");
+  _scheduler->tick();
+  // Sleep until the next release instead of spinning
+  delay(_scheduler->idleMs());
+}
+
+void Program::radioTask(void *program) {
+  for (;;) {
+    static_cast<Program *>(program)->service();
+    os::sleepMs(RADIO_MS);
+  }
+}
+
+void Program::service() {
+  // Write the lines logged since the previous run, as far as the UART takes them without blocking
+  _logger->drain();
+
+  // Sender step: hand the messages queued since the previous run to the BLE stack
+  _bleManager->loop();
+
+  // Settings applied at boot: the lines logged before the reboot must reach the UART
+  if (_bleManager->rebootDue()) {
+    _logger->flush();
+    _bleManager->reboot();
+  }
+
+  if (!_bleManager->isConnected() && millis() - _startAt > (ADVERTISE_SECONDS * 1000)) {
+    LOG_INFO(_logger, "Timeout -> Deep Sleep");
     _logger->flush();
     esp_sleep_enable_timer_wakeup(DEEP_SLEEP_SECONDS * 1000000ULL);
     esp_deep_sleep_start();
   }
 }
 
-WaterTankNotifier *Program::createNotifier(const char *name, const char *channelId, Stream &stream, Logger *logger) {
-  logger->info("Setup %s...", name);
+// Run the listeners on the commands and subscriptions received since the previous run
+void Program::dispatchCommands() { _bleManager->dispatch(); }
+
+// Persist any save made outside a settings transaction
+void Program::persistSettings() { _settings->flush(); }
+
+void Program::sampleTanks() {
+  if (_bleManager->isConnected()) {
+    _cleanTank->notifier.notify();
+    _greyTank->notifier.notify();
+  }
+}
+
+void Program::checkValve() {
+  if (_bleManager->isConnected()) {
+    _greyValve->loop();
+  }
+}
+
+// Hampel over 7 samples (15 while driving, spikes beyond 10 mm); tracker alpha 1/2,
+// beta 1/10, rate averaged over ~64 samples
+Program::Tank::Tank(const char *name, const char *channelId, Stream &stream, Settings *settings, Logger *logger)
+    : sensor(stream, logger), filter(HampelFilter(7, 15, 10), FixedMedianFilter<5>(), AlphaBetaFilter(1, 2, 1, 10, 6)),
+      input(&sensor), listner(name, channelId, settings), notifier(name, &listner, &input, &filter, TICK_MS, logger) {
+  input.addFilter(&filter);
+}
 
-  BleChannel *tankChannel = _bleManager->addChannel(new WaterTankListner(name, channelId, _settings));
-  InputSignal *tankInput = new InputSignal(new UltrasonicSensor(stream, _logger));
-  tankInput->addFilter(new MedianFilter(9));
-  tankInput->addFilter(new EmaFilter(0.5));
-  return new WaterTankNotifier(name, tankChannel, tankInput, _logger);
+void Program::setupTank(Deferred<Tank> &tank, const char *name, const char *channelId, Stream &stream) {
+  LOG_INFO(_logger, "Setup %s...", name);
+  tank.emplace(name, channelId, stream, _settings, _logger.get());
+  _bleManager->addChannel(&tank->listner);
 }
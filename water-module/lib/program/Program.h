@@ -1,9 +1,14 @@
 #pragma once
 #include "BleManager.h"
+#include "Deferred.h"
+#include "InputSignal.h"
 #include "Logger.h"
-#include "SensorBase.h"
+#include "Os.h"
+#include "Scheduler.h"
 #include "Settings.h"
 #include "TankValveListner.h"
+#include "UltrasonicSensor.h"
+#include "WaterTankListner.h"
 #include "WaterTankNotifier.h"
 #include <Arduino.h>
 
@@ -14,13 +19,35 @@ public:
   void loop();
 
 private:
+  // Everything one tank owns: its sensor, filters, BLE channel and notifier
+  struct Tank {
+    UltrasonicSensor sensor;
+    TankFilter filter;
+    InputSignal input;
+    WaterTankListner listner;
+    WaterTankNotifier notifier;
+
+    Tank(const char *name, const char *channelId, Stream &stream, Settings *settings, Logger *logger);
+  };
+
   unsigned long _startAt;
-  Sensor *_sensor = nullptr;
-  Logger *_logger = nullptr;
-  BleManager *_bleManager = nullptr;
   Settings *_settings = nullptr;
-  WaterTankNotifier *_cleanTank = nullptr;
-  WaterTankNotifier *_greyTank = nullptr;
-  TankValveListner *_greyValve = nullptr;
-  WaterTankNotifier *createNotifier(const char *name, const char *channelId, Stream &stream, Logger *logger);
+  // The object graph lives here, built in place by setup(): nothing is allocated on the heap
+  Deferred<Logger> _logger;
+  Deferred<BleManager> _bleManager;
+  Deferred<Tank> _cleanTank;
+  Deferred<Tank> _greyTank;
+  Deferred<TankValveListner> _greyValve;
+  MillisClock _clock;
+  Deferred<Scheduler> _scheduler;
+
+  void setupTank(Deferred<Tank> &tank, const char *name, const char *channelId, Stream &stream);
+  // Radio task, on the other core: logging, BLE sender step, advertising timeout
+  static void radioTask(void *program);
+  void service();
+  // Scheduled tasks, on the loop task
+  void dispatchCommands();
+  void persistSettings();
+  void sampleTanks();
+  void checkValve();
 };
@@ -1,52 +1,61 @@
 #include "TankValveListner.h"
 #include "Arduino.h"
+#include "FixedWriter.h"
 
 TankValveListner::TankValveListner(const char *name, const char *channelId, int relayPin, Settings *settings)
-    : _relayPin(relayPin), _settings(new ValveSettings(settings, name)) {
+    : _relayPin(relayPin), _settings(settings, name), _protocol(&_settings) {
   this->name = name;
   this->channelId = channelId;
-  _protocol = new ValveCfgProtocol(this->_settings);
   pinMode(relayPin, OUTPUT);
   digitalWrite(relayPin, LOW);
 }
 
-TankValveListner::~TankValveListner() { delete _protocol; }
+constexpr CommandTable<TankValveListner, 4> TankValveListner::COMMANDS({
+    {"OPEN", &TankValveListner::open},
+    {"CLOSE", &TankValveListner::close},
+    {"CFG?", &TankValveListner::configure},
+    {"CFG:", &TankValveListner::configure},
+});
 
-void TankValveListner::onReceive(std::string value) {
-  if (value.empty()) {
-    return;
+void TankValveListner::onReceive(std::string_view command) {
+  static_assert(COMMANDS.isPerfect(), "Two verbs share a hash slot");
+  // The valve commands answer through their own messages, unknown ones are ignored
+  CommandReply reply;
+  COMMANDS.dispatch(*this, command, "", reply);
+  if (reply.size() > 0) {
+    send(reply);
   }
+}
 
-  // Try config protocol first
-  std::string response = _protocol->handle(value);
-  if (!response.empty()) {
-    send(response);
-    return;
-  }
+void TankValveListner::open(const CommandArgs &, CommandReply &) { openValve(); }
 
-  // Handle valve commands
-  if (value == "OPEN") {
-    openValve();
-  } else if (value == "CLOSE") {
-    closeValve("CLOSED");
-  }
+void TankValveListner::close(const CommandArgs &, CommandReply &) { closeValve("CLOSED"); }
+
+void TankValveListner::configure(const CommandArgs &args, CommandReply &reply) {
+  _protocol.handle(args.command, reply);
 }
 
 void TankValveListner::openValve() {
   digitalWrite(_relayPin, HIGH);
   _isOpen = true;
-  _remainingSeconds = _settings->getAutoCloseSeconds();
+  _remainingSeconds = _settings.getAutoCloseSeconds();
   _lastTickMs = millis();
 
   // Send initial countdown
-  send(std::string("COUNTDOWN:") + std::to_string(_remainingSeconds));
+  sendCountdown();
 }
 
 void TankValveListner::closeValve(const char *reason) {
   digitalWrite(_relayPin, LOW);
   _isOpen = false;
   _remainingSeconds = 0;
-  send(std::string(reason));
+  send(reason);
+}
+
+void TankValveListner::sendCountdown() {
+  FixedWriter<OutboundQueue::MAX_MESSAGE_SIZE> message;
+  message.append("COUNTDOWN:").appendInt(_remainingSeconds);
+  send(message, OutboundQueue::DROP_OLDEST);
 }
 
 void TankValveListner::loop() {
@@ -66,7 +75,7 @@ void TankValveListner::loop() {
       closeValve("AUTO_CLOSED");
     } else {
       // Send countdown notification
-      send(std::string("COUNTDOWN:") + std::to_string(_remainingSeconds));
+      sendCountdown();
     }
   }
 }
@@ -1,26 +1,33 @@
 #pragma once
 
 #include "BleChannel.h"
+#include "CommandTable.h"
 #include "ValveCfgProtocol.h"
 #include "ValveSettings.h"
 
 class TankValveListner : public BleListner {
   int _relayPin;
-  ValveSettings *_settings;
-  ValveCfgProtocol *_protocol;
+  ValveSettings _settings;
+  ValveCfgProtocol _protocol;
 
   // Timer state
   int _remainingSeconds = 0;
   unsigned long _lastTickMs = 0;
   bool _isOpen = false;
 
-  void onReceive(std::string value) override;
+  // Valve commands first, the CFG ones forwarded to the config protocol
+  static const CommandTable<TankValveListner, 4> COMMANDS;
+
+  void onReceive(std::string_view command) override;
+  void open(const CommandArgs &args, CommandReply &reply);
+  void close(const CommandArgs &args, CommandReply &reply);
+  void configure(const CommandArgs &args, CommandReply &reply);
   void openValve();
   void closeValve(const char *reason);
+  void sendCountdown();
 
 public:
   TankValveListner(const char *name, const char *channelId, int relayPin, Settings *settings);
-  ~TankValveListner();
 
   // Call this from main loop to handle countdown
   void loop();
@@ -1,23 +1,68 @@
 #pragma once
 
 #include "BleChannel.h"
+#include "FixedWriter.h"
 #include "TankSettings.h"
+#include "TelemetryListner.h"
 
 #include "TankCfgProtocol.h"
 
-class WaterTankListner : public BleListner {
+class WaterTankListner : public TelemetryListner {
 private:
+  TankSettings _tankSettings;
+  TankGeometry _geometry;
   TankCfgProtocol _protocol;
 
-  void onReceive(std::string value) override {
-    const std::string resp = _protocol.handle(value);
-    this->send(resp);
+  void onReceive(std::string_view command) override {
+    CommandReply reply;
+    handleTelemetry(command, reply);
+    if (reply.size() == 0) {
+      _protocol.handle(command, reply);
+    }
+    this->send(reply);
   }
 
 public:
   WaterTankListner(const char *name, const char *channelId, Settings *settings)
-      : _protocol(TankCfgProtocol(new TankSettings(settings, name))) {
+      : TelemetryListner(name, settings, 1), _tankSettings(settings, name),
+        _protocol(&_tankSettings, &_geometry) {
     this->name = name;
     this->channelId = channelId;
+    _tankSettings.loadGeometry(_geometry);
+  }
+
+  void onSubscribe() override {
+    _protocol.resetVolumeLines();
+    TelemetryListner::onSubscribe();
+  }
+
+  // Sends the distance, then the volume and fill rate, when the distance moved past the
+  // deadband or the heartbeat expired. In text the volume line only goes to a subscriber
+  // that asked for it with VOL:ON. distanceRate is in tenths of mm per minute (see
+  // AlphaBetaFilter).
+  void notifyLevel(int distanceMm, int distanceRate) {
+    if (!shouldPublish(&distanceMm, 1)) {
+      return;
+    }
+    const int levelMm = _geometry.levelMm(distanceMm);
+    const int volume = _geometry.deciLiters(levelMm);
+    // The distance grows as the tank drains: flip the sign to get the level rate
+    const int rate = _geometry.deciLitersPerMinute(levelMm, -distanceRate);
+    if (binaryFrames()) {
+      const TelemetryFrame::TankLevel level = {TelemetryFrame::toUint16(distanceMm)};
+      publishFrame(level);
+      const TelemetryFrame::TankVolume tankVolume = {TelemetryFrame::toUint16(volume), TelemetryFrame::toInt16(rate)};
+      publishFrame(tankVolume);
+    } else {
+      FixedWriter<OutboundQueue::MAX_MESSAGE_SIZE> message;
+      message.appendInt(distanceMm);
+      this->send(message, OutboundQueue::DROP_OLDEST);
+      if (!_protocol.volumeLines()) {
+        return;
+      }
+      message.clear();
+      message.append("VOL:V=").appendInt(volume).append(";R=").appendInt(rate);
+      this->send(message, OutboundQueue::DROP_OLDEST);
+    }
   }
 };
@@ -2,11 +2,24 @@
 
 void WaterTankNotifier::notify() {
   int distance = _signal->read();
+  reportMotion();
   if (distance < 0) {
-    _logger->debug("%s: Sensor not available yet", _name);
+    LOG_DEBUG(_logger, "%s: Sensor not available yet", _name);
     return;
   } else {
-    _logger->debug("%s: Distance: %d mm", _name, distance);
-    _channel->sendData(String(distance).c_str());
+    LOG_DEBUG(_logger, "%s: Distance: %d mm", _name, distance);
+    _listner->notifyLevel(distance, _filter->stage<AlphaBetaFilter>().getRate(_samplePeriodMs));
   }
-}
\ No newline at end of file
+}
+
+// Logs when the outlier stage enters or leaves its motion mode, with its counters
+void WaterTankNotifier::reportMotion() {
+  const HampelFilter &outliers = _filter->stage<HampelFilter>();
+  if (outliers.inMotion() == _inMotion) {
+    return;
+  }
+  _inMotion = outliers.inMotion();
+  LOG_INFO(_logger, "%s: motion mode %s, %lu samples rejected (%lu in motion, %lu motion periods)", _name,
+           _inMotion ? "on" : "off", outliers.getRejectedCount(), outliers.getRejectedInMotionCount(),
+           outliers.getMotionCount());
+}
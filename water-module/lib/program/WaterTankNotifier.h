@@ -1,16 +1,32 @@
 #pragma once
-#include "BleChannel.h"
+#include "AlphaBetaFilter.h"
+#include "FilterPipeline.h"
+#include "FixedMedianFilter.h"
+#include "HampelFilter.h"
 #include "InputSignal.h"
 #include "Logger.h"
+#include "WaterTankListner.h"
+
+// Filters of each tank distance: the Hampel stage drops echo spikes (sloshing included),
+// the median what is left, the tracker follows the level and its rate
+using TankFilter = FilterPipeline<HampelFilter, FixedMedianFilter<5>, AlphaBetaFilter>;
 
 class WaterTankNotifier {
   const char *_name;
-  BleChannel *_channel;
+  WaterTankListner *_listner;
   InputSignal *_signal;
+  // Filters of the signal, read for the fill rate and the outlier counters
+  TankFilter *_filter;
+  int _samplePeriodMs;
   Logger *_logger;
+  bool _inMotion = false;
+
+  void reportMotion();
 
 public:
   void notify();
-  WaterTankNotifier(const char *name, BleChannel *channel, InputSignal *signal, Logger *logger)
-      : _name(name), _channel(channel), _signal(signal), _logger(logger) {}
+  WaterTankNotifier(const char *name, WaterTankListner *listner, InputSignal *signal, TankFilter *filter,
+                    int samplePeriodMs, Logger *logger)
+      : _name(name), _listner(listner), _signal(signal), _filter(filter), _samplePeriodMs(samplePeriodMs),
+        _logger(logger) {}
 };
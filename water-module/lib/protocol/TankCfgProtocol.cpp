@@ -1,54 +1,125 @@
 #include "TankCfgProtocol.h"
-#include "Check.h"
+#include "CommandFields.h"
 #include <algorithm>
-#include <cctype>
-#include <string>
-
-TankCfgProtocol::TankCfgProtocol(TankSettings *tankSettings) : _tankSettings(tankSettings) {}
-
-std::string TankCfgProtocol::extractValue(const std::string &cmd, const char *key) {
-  const std::string needle = std::string(key) + "=";
-  const size_t pos = cmd.find(needle);
-  if (pos == std::string::npos)
-    return "";
-  const size_t start = pos + needle.length();
-  const size_t end = cmd.find(';', start);
-  if (end == std::string::npos)
-    return cmd.substr(start);
-  return cmd.substr(start, end - start);
-}
-
-std::string TankCfgProtocol::handle(std::string rx) {
-  if (rx == "CFG?") {
-    const int v = _tankSettings->getVolumeLiters();
-    const int h = _tankSettings->getHeightMm();
-    return std::string("CFG:V=") + std::to_string(v) + ";H=" + std::to_string(h);
+
+TankCfgProtocol::TankCfgProtocol(TankSettings *tankSettings, TankGeometry *geometry)
+    : _tankSettings(tankSettings), _geometry(geometry) {}
+
+void TankCfgProtocol::reloadGeometry() {
+  if (_geometry != nullptr) {
+    _tankSettings->loadGeometry(*_geometry);
   }
+}
 
-  if (startsWith(rx, "CFG:")) {
-    std::string vStr = extractValue(rx, "V");
-    std::string hStr = extractValue(rx, "H");
+namespace {
+constexpr CommandErrors CFG_ERRORS = {"ERR_CFG_FMT", "ERR_CFG_NUM", "ERR_CFG_RANGE"};
+} // namespace
 
-    if (vStr.empty() || hStr.empty()) {
-      return "ERR_CFG_FMT";
-    }
+// Keep loose sanity bounds.
+constexpr CommandTable<TankCfgProtocol, 6> TankCfgProtocol::COMMANDS({
+    {"CFG?", &TankCfgProtocol::readConfig},
+    {"CFG:", &TankCfgProtocol::writeConfig, CFG_ERRORS, {{"V", 1, 5000}, {"H", 1, 10000}}},
+    {"TBL?", &TankCfgProtocol::readTable},
+    {"TBL:", &TankCfgProtocol::writeTable},
+    {"VOL?", &TankCfgProtocol::readVolumeLines},
+    {"VOL:", &TankCfgProtocol::writeVolumeLines},
+});
 
-    if (!isStrictPositiveInt(vStr) || !isStrictPositiveInt(hStr)) {
-      return "ERR_CFG_NUM";
-    }
+void TankCfgProtocol::handle(std::string_view rx, CommandReply &reply) {
+  static_assert(COMMANDS.isPerfect(), "Two verbs share a hash slot");
+  COMMANDS.dispatch(*this, rx, "ERR_UNKNOWN_CMD", reply);
+}
+
+void TankCfgProtocol::readConfig(const CommandArgs &, CommandReply &reply) {
+  const int v = _tankSettings->getVolumeLiters();
+  const int h = _tankSettings->getHeightMm();
+  reply.append("CFG:V=").appendInt(v).append(";H=").appendInt(h);
+}
+
+void TankCfgProtocol::writeConfig(const CommandArgs &args, CommandReply &reply) {
+  _tankSettings->setGeometry(args.values[0], args.values[1]);
+  reloadGeometry();
+  reply.append("OK");
+}
 
-    const int v = std::stoi(vStr);
-    const int h = std::stoi(hStr);
+// "TBL:" then up to MAX_POINTS "hhhhh:lllll,"
+static_assert(4 + TankGeometry::MAX_POINTS * 12 <= CommandReply::CAPACITY, "A full table must fit the reply");
 
-    // Keep loose sanity bounds.
-    if (v <= 0 || v > 5000 || h <= 0 || h > 10000) {
-      return "ERR_CFG_RANGE";
+void TankCfgProtocol::readTable(const CommandArgs &, CommandReply &reply) {
+  TankGeometry::Point points[TankGeometry::MAX_POINTS];
+  int count = 0;
+  if (!TankGeometry::decode(_tankSettings->getTable(), points, count) || count == 0) {
+    reply.append("TBL:NONE");
+    return;
+  }
+  reply.append("TBL:");
+  for (int i = 0; i < count; i++) {
+    if (i > 0) {
+      reply.append(',');
     }
+    reply.appendInt(points[i].heightMm).append(':').appendInt(points[i].liters);
+  }
+}
 
-    _tankSettings->setVolumeLiters(v);
-    _tankSettings->setHeightMm(h);
+// The points are a list, not KEY=VAL fields: validated here
+void TankCfgProtocol::writeTable(const CommandArgs &args, CommandReply &reply) {
+  reply.append(storeTable(args.body));
+}
+
+const char *TankCfgProtocol::storeTable(std::string_view body) {
+  if (body == "CLR") {
+    _tankSettings->setTable("");
+    reloadGeometry();
     return "OK";
   }
 
-  return "ERR_UNKNOWN_CMD";
+  TankGeometry::Point points[TankGeometry::MAX_POINTS];
+  int count = 0;
+  std::string_view rest = body;
+  for (;;) {
+    const size_t end = rest.find(',');
+    const std::string_view point = rest.substr(0, end);
+    const size_t colon = point.find(':');
+    if (count == TankGeometry::MAX_POINTS || colon == std::string_view::npos) {
+      return "ERR_TBL_FMT";
+    }
+    int h = 0;
+    int l = 0;
+    const ParseStatus status =
+        std::max(parseInt(point.substr(0, colon), 0, 10000, h), parseInt(point.substr(colon + 1), 0, 5000, l));
+    if (status != ParseStatus::OK) {
+      return CommandFields::errorFor(status, "ERR_TBL_NUM", "ERR_TBL_NUM", "ERR_TBL_RANGE");
+    }
+    points[count++] = {static_cast<uint16_t>(h), static_cast<uint16_t>(l)};
+    if (end == std::string_view::npos) {
+      break;
+    }
+    rest.remove_prefix(end + 1);
+  }
+
+  if (!TankGeometry::isValid(points, count)) {
+    return "ERR_TBL_RANGE";
+  }
+
+  TankGeometry table;
+  table.setTable(points, count);
+  _tankSettings->setTable(table.encode());
+  reloadGeometry();
+  return "OK";
+}
+
+void TankCfgProtocol::readVolumeLines(const CommandArgs &, CommandReply &reply) {
+  reply.append(_volumeLines ? "VOL:ON" : "VOL:OFF");
+}
+
+void TankCfgProtocol::writeVolumeLines(const CommandArgs &args, CommandReply &reply) {
+  if (args.body == "ON") {
+    _volumeLines = true;
+  } else if (args.body == "OFF") {
+    _volumeLines = false;
+  } else {
+    reply.append("ERR_VOL");
+    return;
+  }
+  reply.append("OK");
 }
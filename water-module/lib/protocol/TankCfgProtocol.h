@@ -1,18 +1,45 @@
 #pragma once
 
+#include "CommandTable.h"
+#include "TankGeometry.h"
 #include "TankSettings.h"
-#include <string>
+#include <string_view>
 
 // RX commands:
 // - "CFG?"                     -> responds "CFG:V=<liters>;H=<mm>"
 // - "CFG:V=<liters>;H=<mm>"    -> persists + responds "OK" or "ERR_*"
+// - "TBL?"                     -> responds "TBL:<mm>:<liters>,..." or "TBL:NONE"
+// - "TBL:<mm>:<liters>,..."    -> persists the calibration table + responds "OK" or "ERR_*"
+// - "TBL:CLR"                  -> drops the table (box-shaped tank) + responds "OK"
+// - "VOL?"                     -> responds "VOL:ON" or "VOL:OFF"
+// - "VOL:ON" / "VOL:OFF"       -> selects the VOL: text lines + responds "OK" or "ERR_VOL"
 // Any other input -> "ERR_UNKNOWN_CMD"
+// The VOL: lines are opt-in and not persisted: every new subscriber starts without them,
+// so a client that only parses distances never receives one.
 class TankCfgProtocol {
   TankSettings *_tankSettings;
+  TankGeometry *_geometry;
+  bool _volumeLines = false;
 
-  static std::string extractValue(const std::string &cmd, const char *key);
+  static const CommandTable<TankCfgProtocol, 6> COMMANDS;
+
+  void readConfig(const CommandArgs &args, CommandReply &reply);
+  void writeConfig(const CommandArgs &args, CommandReply &reply);
+  void readTable(const CommandArgs &args, CommandReply &reply);
+  void writeTable(const CommandArgs &args, CommandReply &reply);
+  void readVolumeLines(const CommandArgs &args, CommandReply &reply);
+  void writeVolumeLines(const CommandArgs &args, CommandReply &reply);
+  // Validates and persists a TBL: body, returns the response
+  const char *storeTable(std::string_view body);
+  // Applies a successful write to the geometry the notifier converts with
+  void reloadGeometry();
 
 public:
-  explicit TankCfgProtocol(TankSettings *tankSettings);
-  std::string handle(std::string rx);
+  // geometry, when given, is reloaded after each accepted write
+  explicit TankCfgProtocol(TankSettings *tankSettings, TankGeometry *geometry = nullptr);
+  // Writes the response into reply
+  void handle(std::string_view rx, CommandReply &reply);
+  // True when the subscriber asked for the VOL: text lines
+  bool volumeLines() const { return _volumeLines; }
+  void resetVolumeLines() { _volumeLines = false; }
 };
@@ -1,7 +1,8 @@
 #pragma once
 
+#include "CommandTable.h"
 #include "ValveSettings.h"
-#include <string>
+#include <string_view>
 
 // RX commands:
 // - "CFG?"                -> responds "CFG:T=<seconds>"
@@ -10,9 +11,13 @@
 class ValveCfgProtocol {
   ValveSettings *_valveSettings;
 
-  static std::string extractValue(const std::string &cmd, const char *key);
+  static const CommandTable<ValveCfgProtocol, 2> COMMANDS;
+
+  void readConfig(const CommandArgs &args, CommandReply &reply);
+  void writeConfig(const CommandArgs &args, CommandReply &reply);
 
 public:
   explicit ValveCfgProtocol(ValveSettings *valveSettings);
-  std::string handle(std::string rx);
+  // Writes the response into reply
+  void handle(std::string_view rx, CommandReply &reply);
 };
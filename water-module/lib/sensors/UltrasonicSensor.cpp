@@ -1,39 +1,71 @@
 #include "UltrasonicSensor.h"
+#include <string.h>
 
 UltrasonicSensor::UltrasonicSensor(Stream &stream, Logger *logger) : _serial(stream), _logger(logger) {}
 
 int UltrasonicSensor::read() {
   int lastDistance = -1;
 
-  while (_serial.available() >= PACKET_SIZE) {
-    int distance = readPacket();
+  int available = _serial.available();
+  while (available > 0) {
+    const int room = BUFFER_SIZE - _length;
+    const int count = available < room ? available : room;
+    const int received = static_cast<int>(_serial.readBytes(reinterpret_cast<char *>(_buffer + _length), count));
+    if (received <= 0) {
+      break;
+    }
+    _length += received;
+
+    int distance = parseBuffer();
     if (distance >= 0) {
       lastDistance = distance;
     }
+    available = _serial.available();
   }
 
   if (lastDistance < 0) {
-    _logger->debug("Frame not complete done - waiting for more data");
+    LOG_DEBUG(_logger, "Frame not complete done - waiting for more data");
   }
   return lastDistance;
 }
 
-int UltrasonicSensor::readPacket() {
-  if (_serial.read() != PACKET_HEADER) {
-    _logger->debug("Header missing - byte ignored.");
-    return -1;
-  }
+// Consumes every complete packet of the buffer, sliding one byte at a time past
+// anything that is not a valid packet. Returns the last distance found, or -1.
+int UltrasonicSensor::parseBuffer() {
+  int lastDistance = -1;
+  int start = 0;
 
-  unsigned char highPart = _serial.read();
-  unsigned char lowPart = _serial.read();
-  unsigned char checksum = _serial.read();
+  while (_length - start >= PACKET_SIZE) {
+    const uint8_t *packet = _buffer + start;
+    if (packet[0] != PACKET_HEADER) {
+      skipByte();
+      start++;
+      continue;
+    }
+    if (packet[3] != computeChecksum(packet[1], packet[2])) {
+      // The header may have been a data byte: resync from the next one
+      _checksumErrors++;
+      _hunting = true;
+      start++;
+      continue;
+    }
 
-  if (checksum != computeChecksum(highPart, lowPart)) {
-    _logger->debug("Checksum error - packet ignored");
-    return -1;
+    lastDistance = (packet[1] << 8) + packet[2]; // raw mm
+    _hunting = false;
+    start += PACKET_SIZE;
   }
 
-  return (highPart << 8) + lowPart; // raw mm
+  // Keep the start of the next packet
+  _length -= start;
+  memmove(_buffer, _buffer + start, _length);
+  return lastDistance;
+}
+
+void UltrasonicSensor::skipByte() {
+  if (!_hunting) {
+    _framingErrors++;
+    _hunting = true;
+  }
 }
 
 unsigned char UltrasonicSensor::computeChecksum(unsigned char high, unsigned char low) {
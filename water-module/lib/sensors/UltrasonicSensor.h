@@ -12,12 +12,27 @@ public:
   int read();
   int maxRange() override { return 1000; } // 1 meters max range
 
+  // Packets with a header whose checksum did not match
+  unsigned long getChecksumErrorCount() const { return _checksumErrors; }
+  // Times the parser lost sync and skipped bytes to find the next header
+  unsigned long getFramingErrorCount() const { return _framingErrors; }
+
 private:
   Stream &_serial;
   Logger *_logger;
   static const int PACKET_SIZE = 4; // 1 byte header + 2 bytes distance (high & low) + 1 byte checksum
   static const uint8_t PACKET_HEADER = 0xFF;
+  // Bytes drained per readBytes(); a partial packet stays at the front until completed
+  static const int BUFFER_SIZE = 64;
+
+  uint8_t _buffer[BUFFER_SIZE];
+  int _length = 0;
+  // Skipping bytes since the last valid packet, counted as one framing error
+  bool _hunting = false;
+  unsigned long _checksumErrors = 0;
+  unsigned long _framingErrors = 0;
 
-  int readPacket();
+  int parseBuffer();
+  void skipByte();
   unsigned char computeChecksum(unsigned char high, unsigned char low);
 };
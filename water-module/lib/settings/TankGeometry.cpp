@@ -0,0 +1,148 @@
+#include "TankGeometry.h"
+
+namespace {
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+void writeHex(std::string &out, uint16_t value) {
+  for (int shift = 12; shift >= 0; shift -= 4) {
+    out += HEX_DIGITS[(value >> shift) & 0xF];
+  }
+}
+
+bool readHex(const char *in, uint16_t &value) {
+  value = 0;
+  for (int i = 0; i < 4; i++) {
+    const char c = in[i];
+    int digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else {
+      return false;
+    }
+    value = static_cast<uint16_t>((value << 4) | digit);
+  }
+  return true;
+}
+} // namespace
+
+void TankGeometry::setBox(int liters, int heightMm) {
+  _boxLiters = liters;
+  _heightMm = heightMm;
+  if (!_hasTable) {
+    useBox();
+  }
+}
+
+void TankGeometry::useBox() {
+  _points[0] = {0, 0};
+  _points[1] = {static_cast<uint16_t>(_heightMm), static_cast<uint16_t>(_boxLiters)};
+  _count = 2;
+}
+
+bool TankGeometry::setTable(const Point *points, int count) {
+  if (count == 0) {
+    _hasTable = false;
+    useBox();
+    return true;
+  }
+  if (!isValid(points, count)) {
+    return false;
+  }
+  for (int i = 0; i < count; i++) {
+    _points[i] = points[i];
+  }
+  _count = count;
+  _hasTable = true;
+  return true;
+}
+
+bool TankGeometry::isValid(const Point *points, int count) {
+  if (count < 2 || count > MAX_POINTS) {
+    return false;
+  }
+  for (int i = 1; i < count; i++) {
+    if (points[i].heightMm <= points[i - 1].heightMm || points[i].liters < points[i - 1].liters) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int TankGeometry::levelMm(int distanceMm) const {
+  const int level = _heightMm - distanceMm;
+  return level < 0 ? 0 : (level > _heightMm ? _heightMm : level);
+}
+
+int TankGeometry::segment(int levelMm) const {
+  // Last point at or below levelMm, kept inside [0, _count - 2]
+  int low = 0;
+  int high = _count - 2;
+  while (low < high) {
+    const int middle = (low + high + 1) / 2;
+    if (_points[middle].heightMm <= levelMm) {
+      low = middle;
+    } else {
+      high = middle - 1;
+    }
+  }
+  return low;
+}
+
+int TankGeometry::deciLiters(int levelMm) const {
+  const Point &first = _points[0];
+  const Point &last = _points[_count - 1];
+  if (levelMm <= first.heightMm) {
+    return first.liters * 10;
+  }
+  if (levelMm >= last.heightMm) {
+    return last.liters * 10;
+  }
+
+  const int i = segment(levelMm);
+  const Point &from = _points[i];
+  const Point &to = _points[i + 1];
+  const long rise = static_cast<long>(to.liters - from.liters) * 10 * (levelMm - from.heightMm);
+  return from.liters * 10 + static_cast<int>(rise / (to.heightMm - from.heightMm));
+}
+
+int TankGeometry::deciLitersPerMinute(int levelMm, int levelRate) const {
+  const int i = segment(levelMm);
+  const Point &from = _points[i];
+  const Point &to = _points[i + 1];
+  // Tenths of mm to tenths of a liter: liters per mm of the segment
+  return static_cast<int>(static_cast<long long>(levelRate) * (to.liters - from.liters) /
+                          (to.heightMm - from.heightMm));
+}
+
+std::string TankGeometry::encode() const {
+  std::string encoded;
+  if (!_hasTable) {
+    return encoded;
+  }
+  encoded.reserve(_count * ENCODED_POINT_SIZE);
+  for (int i = 0; i < _count; i++) {
+    writeHex(encoded, _points[i].heightMm);
+    writeHex(encoded, _points[i].liters);
+  }
+  return encoded;
+}
+
+bool TankGeometry::decode(const std::string &encoded, Point *points, int &count) {
+  if (encoded.length() % ENCODED_POINT_SIZE != 0 || encoded.length() > MAX_POINTS * ENCODED_POINT_SIZE) {
+    return false;
+  }
+  const int decoded = static_cast<int>(encoded.length() / ENCODED_POINT_SIZE);
+  for (int i = 0; i < decoded; i++) {
+    const char *point = encoded.c_str() + i * ENCODED_POINT_SIZE;
+    if (!readHex(point, points[i].heightMm) || !readHex(point + 4, points[i].liters)) {
+      return false;
+    }
+  }
+  if (decoded > 0 && !isValid(points, decoded)) {
+    return false;
+  }
+  count = decoded;
+  return true;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <stdint.h>
+#include <string>
+
+// Water volume as a function of the water height, for tanks that are not rectangular:
+// a calibration table of (height, liters) points interpolated linearly, looked up by
+// binary search. Without a table the tank is a box: (0, 0) to (height, volume).
+class TankGeometry {
+public:
+  // Fits a TBL? response (see TankCfgProtocol) in one outbound message
+  static constexpr int MAX_POINTS = 10;
+  // Characters per point in the stored table: height then liters, 4 hex digits each
+  static constexpr int ENCODED_POINT_SIZE = 8;
+
+  struct Point {
+    uint16_t heightMm;
+    uint16_t liters;
+  };
+
+  // heightMm is the distance from the sensor to the bottom of the tank
+  void setBox(int liters, int heightMm);
+  // A count of 0 goes back to the box. False (and no change) unless 2 to MAX_POINTS points with strictly increasing
+  // heights and non-decreasing volumes
+  bool setTable(const Point *points, int count);
+  static bool isValid(const Point *points, int count);
+
+  bool hasTable() const { return _hasTable; }
+  int getPointCount() const { return _count; }
+  const Point &getPoint(int index) const { return _points[index]; }
+
+  // Water height above the bottom for a sensor distance, clamped to the tank
+  int levelMm(int distanceMm) const;
+  // Volume in tenths of a liter at that water height
+  int deciLiters(int levelMm) const;
+  // Volume change in tenths of a liter per minute, for a water height moving by
+  // levelRate tenths of mm per minute, from the slope of the table at levelMm
+  int deciLitersPerMinute(int levelMm, int levelRate) const;
+
+  // Compact form stored in the settings, empty without a table
+  std::string encode() const;
+  // False on a malformed or invalid table, nothing decoded
+  static bool decode(const std::string &encoded, Point *points, int &count);
+
+private:
+  int _boxLiters = 0;
+  int _heightMm = 0;
+  bool _hasTable = false;
+  Point _points[MAX_POINTS] = {};
+  int _count = 0;
+
+  void useBox();
+  // Index of the segment [i, i + 1] containing levelMm
+  int segment(int levelMm) const;
+};
@@ -1,20 +1,39 @@
 #include "TankSettings.h"
-#include <string>
 
-int TankSettings::getVolumeLiters() {
-  const std::string key = std::string(_name) + "_v_l";
-  return _settings->get(key.c_str(), 150);
-}
+int TankSettings::getVolumeLiters() { return _settings->get(_volumeKey.c_str(), 150); }
 void TankSettings::setVolumeLiters(int liters) {
-  const std::string key = std::string(_name) + "_v_l";
-  _settings->save(key.c_str(), liters);
+  _settings->beginTransaction();
+  _settings->save(_volumeKey.c_str(), liters);
+  _settings->commit();
 }
 
-int TankSettings::getHeightMm() {
-  const std::string key = std::string(_name) + "_h_mm";
-  return _settings->get(key.c_str(), 500);
-}
+int TankSettings::getHeightMm() { return _settings->get(_heightKey.c_str(), 500); }
 void TankSettings::setHeightMm(int heightMm) {
-  const std::string key = std::string(_name) + "_h_mm";
-  _settings->save(key.c_str(), heightMm);
+  _settings->beginTransaction();
+  _settings->save(_heightKey.c_str(), heightMm);
+  _settings->commit();
+}
+
+void TankSettings::setGeometry(int liters, int heightMm) {
+  _settings->beginTransaction();
+  setVolumeLiters(liters);
+  setHeightMm(heightMm);
+  _settings->commit();
+}
+
+std::string TankSettings::getTable() { return _settings->get(_tableKey.c_str(), std::string()); }
+void TankSettings::setTable(const std::string &encoded) {
+  _settings->beginTransaction();
+  _settings->save(_tableKey.c_str(), encoded.c_str());
+  _settings->commit();
+}
+
+void TankSettings::loadGeometry(TankGeometry &geometry) {
+  geometry.setBox(getVolumeLiters(), getHeightMm());
+  TankGeometry::Point points[TankGeometry::MAX_POINTS];
+  int count = 0;
+  if (!TankGeometry::decode(getTable(), points, count)) {
+    count = 0;
+  }
+  geometry.setTable(points, count);
 }
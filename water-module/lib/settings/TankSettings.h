@@ -1,18 +1,42 @@
 #pragma once
 
 #include "Settings.h"
+#include "SettingsKey.h"
+#include "TankGeometry.h"
 #include <string>
 
 class TankSettings {
+  static constexpr const char *VOLUME_SUFFIX = "_v_l";
+  static constexpr const char *HEIGHT_SUFFIX = "_h_mm";
+  static constexpr const char *TABLE_SUFFIX = "_tbl";
+
   Settings *_settings = nullptr;
-  std::string _name;
+  SettingsKey _volumeKey;
+  SettingsKey _heightKey;
+  SettingsKey _tableKey;
 
 public:
-  TankSettings(Settings *settings, const std::string &name) : _settings(settings), _name(name) {}
-  TankSettings(Settings *settings, const char *name) : _settings(settings), _name(name) {}
+  TankSettings(Settings *settings, const std::string &name) : TankSettings(settings, name.c_str()) {}
+  TankSettings(Settings *settings, const char *name)
+      : _settings(settings), _volumeKey(name, VOLUME_SUFFIX), _heightKey(name, HEIGHT_SUFFIX),
+        _tableKey(name, TABLE_SUFFIX) {}
+
+  // True when every key of a tank with this name fits the NVS limit
+  static constexpr bool fitsName(const char *name) {
+    return SettingsKey::fits(name, VOLUME_SUFFIX) && SettingsKey::fits(name, HEIGHT_SUFFIX) &&
+           SettingsKey::fits(name, TABLE_SUFFIX);
+  }
 
   int getVolumeLiters();
   void setVolumeLiters(int liters);
   int getHeightMm();
   void setHeightMm(int heightMm);
+  // Persists volume and height together, in one settings transaction
+  void setGeometry(int liters, int heightMm);
+  // Calibration table in TankGeometry::encode() form, empty for a box-shaped tank
+  std::string getTable();
+  void setTable(const std::string &encoded);
+  // Fills geometry from the stored volume, height and table. A table that does not
+  // decode is ignored: the tank falls back to a box.
+  void loadGeometry(TankGeometry &geometry);
 };
@@ -1,12 +1,9 @@
 #include "ValveSettings.h"
-#include <string>
 
-int ValveSettings::getAutoCloseSeconds() {
-  const std::string key = std::string(_name) + "_ac_s";
-  return _settings->get(key.c_str(), 30);
-}
+int ValveSettings::getAutoCloseSeconds() { return _settings->get(_autoCloseKey.c_str(), 30); }
 
 void ValveSettings::setAutoCloseSeconds(int seconds) {
-  const std::string key = std::string(_name) + "_ac_s";
-  _settings->save(key.c_str(), seconds);
+  _settings->beginTransaction();
+  _settings->save(_autoCloseKey.c_str(), seconds);
+  _settings->commit();
 }
@@ -1,15 +1,21 @@
 #pragma once
 
 #include "Settings.h"
+#include "SettingsKey.h"
 #include <string>
 
 class ValveSettings {
+  static constexpr const char *AUTO_CLOSE_SUFFIX = "_ac_s";
+
   Settings *_settings = nullptr;
-  std::string _name;
+  SettingsKey _autoCloseKey;
 
 public:
-  ValveSettings(Settings *settings, const std::string &name) : _settings(settings), _name(name) {}
-  ValveSettings(Settings *settings, const char *name) : _settings(settings), _name(name) {}
+  ValveSettings(Settings *settings, const std::string &name) : ValveSettings(settings, name.c_str()) {}
+  ValveSettings(Settings *settings, const char *name) : _settings(settings), _autoCloseKey(name, AUTO_CLOSE_SUFFIX) {}
+
+  // True when every key of a valve with this name fits the NVS limit
+  static constexpr bool fitsName(const char *name) { return SettingsKey::fits(name, AUTO_CLOSE_SUFFIX); }
 
   int getAutoCloseSeconds();
   void setAutoCloseSeconds(int seconds);
@@ -1,4 +1,5 @@
 #include "Arduino.h"
+#include "CachedSettings.h"
 #include "Esp32Settings.h"
 #include "Program.h"
 // Sensor: HC-SR04-like UART ultrasonic sensor
@@ -16,7 +17,12 @@
 // Rates for serial communication
 #define STANDARD_BAUD 9600
 
-static Program program(new Esp32Settings("wt-settings"));
+// Statically allocated, like the whole object graph Program owns
+static Esp32Settings nvsSettings("wt-settings");
+static CachedSettings settings(&nvsSettings);
+static_assert(TankGeometry::MAX_POINTS * TankGeometry::ENCODED_POINT_SIZE <= CachedSettings::MAX_STRING_LENGTH,
+              "A calibration table must fit the settings cache");
+static Program program(&settings);
 
 void setup() {
   Serial.begin(STANDARD_BAUD);
@@ -0,0 +1,30 @@
+#pragma once
+// Replaces the global operator new to count heap allocations made by the test binary.
+// Include from a single .cpp per test folder: the replacement applies to the whole binary.
+#include <cstdlib>
+#include <new>
+
+namespace CountingAllocator {
+inline int &allocations() {
+  static int count = 0;
+  return count;
+}
+} // namespace CountingAllocator
+
+// GCC pairs the inlined malloc() below with the free() of operator delete
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void *operator new(std::size_t size) {
+  CountingAllocator::allocations()++;
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+#pragma GCC diagnostic pop
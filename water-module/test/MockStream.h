@@ -9,11 +9,16 @@ public:
   std::vector<uint8_t> input;
   std::vector<uint8_t> output;
   size_t readIndex = 0;
+  // Calls to read() and readBytes(), to check how the input is drained
+  size_t readCalls = 0;
+  size_t readBytesCalls = 0;
 
   void reset() {
     input.clear();
     output.clear();
     readIndex = 0;
+    readCalls = 0;
+    readBytesCalls = 0;
   }
 
   void addByte(uint8_t b) { input.push_back(b); }
@@ -50,12 +55,22 @@ public:
   int available() override { return static_cast<int>(input.size() - readIndex); }
 
   int read() override {
+    readCalls++;
     if (readIndex < input.size()) {
       return input[readIndex++];
     }
     return -1;
   }
 
+  size_t readBytes(char *buffer, size_t length) override {
+    readBytesCalls++;
+    size_t count = 0;
+    for (; count < length && readIndex < input.size(); count++) {
+      buffer[count] = static_cast<char>(input[readIndex++]);
+    }
+    return count;
+  }
+
   int peek() override {
     if (readIndex < input.size()) {
       return input[readIndex];
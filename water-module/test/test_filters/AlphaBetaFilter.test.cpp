@@ -0,0 +1,138 @@
+#include "AlphaBetaFilter.h"
+#include "EmaFilter.h"
+#include "FilterPipeline.h"
+#include "FixedMedianFilter.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Tank filters of the firmware before and after the tracker
+using MedianEmaChain = FilterPipeline<FixedMedianFilter<9>, EmaFilter>;
+using TrackerChain = FilterPipeline<FixedMedianFilter<5>, AlphaBetaFilter>;
+
+static MedianEmaChain medianEmaChain() { return MedianEmaChain(FixedMedianFilter<9>(), EmaFilter(1, 2)); }
+static TrackerChain trackerChain() { return TrackerChain(FixedMedianFilter<5>(), AlphaBetaFilter(1, 2, 1, 10, 6)); }
+
+// Replayed sensor trace: the true level and what the sensor reported (1 mm resolution,
+// +/-3 mm of noise, and a 300 mm echo spike in about 2% of the samples)
+struct Trace {
+  std::vector<int> level;
+  std::vector<int> measured;
+};
+
+// Level at startMm, moving by stepTenthsMm per sample from sample 50 for rampSamples samples
+static Trace makeTrace(int startMm, int stepTenthsMm, int rampSamples) {
+  Trace trace;
+  unsigned int seed = 7;
+  for (int i = 0; i < 400; i++) {
+    const int moved = i < 50 ? 0 : (i < 50 + rampSamples ? i - 50 : rampSamples);
+    const int level = startMm + moved * stepTenthsMm / 10;
+    seed = seed * 1103515245 + 12345;
+    const int noise = static_cast<int>((seed >> 16) % 7) - 3;
+    const bool spike = (seed >> 8) % 50 == 0;
+    trace.level.push_back(level);
+    trace.measured.push_back(level + noise + (spike ? 300 : 0));
+  }
+  return trace;
+}
+
+// Samples after the level starts moving until the output stays within 5 mm of the level
+// for 20 samples in a row
+static int samplesToSettle(Filter &filter, const Trace &trace) {
+  std::vector<int> output;
+  for (int sample : trace.measured) {
+    output.push_back(filter.apply(sample));
+  }
+  for (size_t start = 50; start + 20 <= output.size(); start++) {
+    bool settled = true;
+    for (size_t i = start; i < start + 20 && settled; i++) {
+      settled = abs(output[i] - trace.level[i]) <= 5;
+    }
+    if (settled) {
+      return static_cast<int>(start - 50);
+    }
+  }
+  return -1;
+}
+
+TEST(AlphaBetaFilter, ReturnsFirstSampleImmediately) {
+  AlphaBetaFilter filter(1, 2, 1, 10, 6);
+
+  EXPECT_EQ(filter.apply(480), 480);
+  EXPECT_EQ(filter.getRate(110), 0);
+}
+
+TEST(AlphaBetaFilter, ZeroSampleDoesNotResetTheTracker) {
+  AlphaBetaFilter filter(1, 2, 1, 10, 6);
+  filter.apply(0);
+
+  EXPECT_EQ(filter.apply(100), 50);
+}
+
+TEST(AlphaBetaFilter, HoldsAConstantLevel) {
+  AlphaBetaFilter filter(1, 2, 1, 10, 6);
+
+  int result = 0;
+  for (int i = 0; i < 100; i++) {
+    result = filter.apply(480);
+  }
+
+  EXPECT_EQ(result, 480);
+  EXPECT_EQ(filter.getRate(110), 0);
+}
+
+TEST(AlphaBetaFilter, TracksARampWithoutLag) {
+  AlphaBetaFilter filter(1, 2, 1, 10, 6);
+
+  int result = 0;
+  for (int i = 0; i < 300; i++) {
+    result = filter.apply(200 + 2 * i);
+  }
+
+  EXPECT_EQ(result, 200 + 2 * 299);
+}
+
+TEST(AlphaBetaFilter, EstimatesTheRatePerMinute) {
+  AlphaBetaFilter filter(1, 2, 1, 10, 6);
+
+  for (int i = 0; i < 600; i++) {
+    filter.apply(900 - i);
+  }
+
+  // -1 mm per 100 ms sample = -600 mm/min
+  EXPECT_NEAR(filter.getRate(100), -6000, 10);
+}
+
+TEST(AlphaBetaFilter, SettlesFasterThanMedianEmaWhileDraining) {
+  const Trace drain = makeTrace(200, 15, 200);
+  MedianEmaChain medianEma = medianEmaChain();
+  TrackerChain tracker = trackerChain();
+
+  const int medianEmaSamples = samplesToSettle(medianEma, drain);
+  const int trackerSamples = samplesToSettle(tracker, drain);
+
+  ASSERT_GE(trackerSamples, 0);
+  EXPECT_TRUE(medianEmaSamples < 0 || trackerSamples < medianEmaSamples)
+      << trackerSamples << " vs " << medianEmaSamples;
+}
+
+TEST(AlphaBetaFilter, SettlesFasterThanMedianEmaWhileFilling) {
+  const Trace fill = makeTrace(700, -20, 200);
+  MedianEmaChain medianEma = medianEmaChain();
+  TrackerChain tracker = trackerChain();
+
+  const int medianEmaSamples = samplesToSettle(medianEma, fill);
+  const int trackerSamples = samplesToSettle(tracker, fill);
+
+  ASSERT_GE(trackerSamples, 0);
+  EXPECT_TRUE(medianEmaSamples < 0 || trackerSamples < medianEmaSamples)
+      << trackerSamples << " vs " << medianEmaSamples;
+}
+
+TEST(AlphaBetaFilter, RejectsEchoSpikesBehindAMedian) {
+  const Trace still = makeTrace(480, 0, 0);
+  TrackerChain tracker = trackerChain();
+
+  for (size_t i = 0; i < still.measured.size(); i++) {
+    ASSERT_NEAR(tracker.apply(still.measured[i]), 480, 5) << "sample " << i;
+  }
+}
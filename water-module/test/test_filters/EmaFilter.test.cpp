@@ -2,7 +2,7 @@
 #include <gtest/gtest.h>
 
 TEST(EmaFilter, ReturnsInitialValueImmediately) {
-  EmaFilter filter(0.5);
+  EmaFilter filter(1, 2);
 
   int result = filter.apply(100);
 
@@ -10,7 +10,7 @@ TEST(EmaFilter, ReturnsInitialValueImmediately) {
 }
 
 TEST(EmaFilter, SmoothsValueWithAlphaZeroPointFive) {
-  EmaFilter filter(0.5);
+  EmaFilter filter(1, 2);
   filter.apply(100);
 
   int result = filter.apply(200);
@@ -19,7 +19,7 @@ TEST(EmaFilter, SmoothsValueWithAlphaZeroPointFive) {
 }
 
 TEST(EmaFilter, ResistsChangeWithLowAlpha) {
-  EmaFilter filter(0.1);
+  EmaFilter filter(1, 10);
 
   filter.apply(100);
   int result = filter.apply(200);
@@ -28,7 +28,7 @@ TEST(EmaFilter, ResistsChangeWithLowAlpha) {
 }
 
 TEST(EmaFilter, ConvergesToConstantInput) {
-  EmaFilter filter(0.5);
+  EmaFilter filter(1, 2);
 
   filter.apply(0); // Start at 0
 
@@ -40,4 +40,74 @@ TEST(EmaFilter, ConvergesToConstantInput) {
   EXPECT_EQ(filter.apply(100), 100);
 }
 
+TEST(EmaFilter, ZeroSampleDoesNotResetTheAverage) {
+  EmaFilter filter(1, 2);
+
+  filter.apply(0);
+  filter.apply(0);
+  int result = filter.apply(100);
+
+  EXPECT_EQ(result, 50);
+}
+
+TEST(EmaFilter, ShiftAlphaMatchesEquivalentRational) {
+  EmaFilter shifted(2);
+  EmaFilter rational(1, 4);
+
+  for (int sample : {800, 812, 790, 805, 1200, 801, 799}) {
+    EXPECT_EQ(shifted.apply(sample), rational.apply(sample));
+  }
+}
+
+TEST(EmaFilter, AccumulatesStepsSmallerThanOneUnit) {
+  EmaFilter filter(3);
+  filter.apply(100);
+
+  // Each sample moves the average by 1/8 mm: an integer average would never move
+  int result = 0;
+  for (int i = 0; i < 12; i++) {
+    result = filter.apply(101);
+  }
+
+  EXPECT_EQ(result, 101);
+}
+
+TEST(EmaFilter, OutputIsBitExact) {
+  EmaFilter filter(3, 10);
+
+  EXPECT_EQ(filter.apply(1000), 1000);
+  EXPECT_EQ(filter.apply(1100), 1030); // Q8: 256000 + 7680 = 263680
+  EXPECT_EQ(filter.apply(900), 991);   // 263680 - 9984 = 253696
+  EXPECT_EQ(filter.apply(-50), 679);   // 253696 - 79948 = 173748 (678.70)
+}
+
 // if you plan to use GMock, replace the line above with
+
+TEST(EmaFilter, ClampsTheShift) {
+  EmaFilter negative(-1);
+  EmaFilter none(0);
+  EmaFilter tooWide(31);
+  EmaFilter widest(EmaFilter::MAX_SHIFT);
+
+  for (int sample : {800, 812, 790, 1200}) {
+    EXPECT_EQ(negative.apply(sample), none.apply(sample));
+    EXPECT_EQ(tooWide.apply(sample), widest.apply(sample));
+  }
+}
+
+TEST(EmaFilter, ClampsTheRatio) {
+  EmaFilter zeroDenominator(1, 0);
+  EmaFilter negativeDenominator(1, -4);
+  EmaFilter zeroNumerator(0, 4);
+  EmaFilter overOne(5, 4);
+  EmaFilter whole(1, 1);
+  EmaFilter smallest(1, 4);
+
+  for (int sample : {800, 812, 790, 1200}) {
+    const int followed = whole.apply(sample);
+    EXPECT_EQ(zeroDenominator.apply(sample), followed);
+    EXPECT_EQ(negativeDenominator.apply(sample), followed);
+    EXPECT_EQ(overOne.apply(sample), followed);
+    EXPECT_EQ(zeroNumerator.apply(sample), smallest.apply(sample));
+  }
+}
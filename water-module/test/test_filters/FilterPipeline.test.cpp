@@ -0,0 +1,55 @@
+#include "EmaFilter.h"
+#include "FilterPipeline.h"
+#include "FixedMedianFilter.h"
+#include "MedianFilter.h"
+#include <gtest/gtest.h>
+
+static const int SAMPLES[] = {800, 805, 1200, 798, 0, 801, 790, 812, 795, 799, 3000, 800, 802};
+
+TEST(FixedMedianFilterTest, MatchesMedianFilter) {
+  MedianFilter dynamic(5);
+  FixedMedianFilter<5> fixed;
+
+  for (int sample : SAMPLES) {
+    EXPECT_EQ(fixed.apply(sample), dynamic.apply(sample));
+  }
+}
+
+TEST(FixedMedianFilterTest, KeepsTheWindowInTheObject) {
+  EXPECT_EQ(sizeof(FixedMedianFilter<9>) - sizeof(FixedMedianFilter<1>), 2 * 8 * sizeof(int));
+}
+
+TEST(FilterPipelineTest, AppliesStagesInOrder) {
+  MedianFilter median(3);
+  EmaFilter ema(1, 2);
+  FilterPipeline<FixedMedianFilter<3>, EmaFilter> pipeline(FixedMedianFilter<3>(), EmaFilter(1, 2));
+
+  for (int sample : SAMPLES) {
+    EXPECT_EQ(pipeline.apply(sample), ema.apply(median.apply(sample)));
+  }
+}
+
+TEST(FilterPipelineTest, DefaultConstructsStages) {
+  FilterPipeline<FixedMedianFilter<3>, FixedMedianFilter<3>> pipeline;
+
+  pipeline.apply(10);
+  pipeline.apply(30);
+  EXPECT_EQ(pipeline.apply(20), 10);
+}
+
+TEST(FilterPipelineTest, IsAFilter) {
+  FilterPipeline<EmaFilter> pipeline(EmaFilter(1, 2));
+  Filter &filter = pipeline;
+
+  filter.apply(100);
+  EXPECT_EQ(filter.apply(200), 150);
+}
+
+TEST(FilterPipelineTest, GivesAccessToAStageByType) {
+  FilterPipeline<FixedMedianFilter<3>, EmaFilter> pipeline(FixedMedianFilter<3>(), EmaFilter(1, 2));
+
+  pipeline.apply(100);
+  pipeline.stage<EmaFilter>().apply(300);
+
+  EXPECT_EQ(pipeline.apply(100), 150);
+}
@@ -0,0 +1,143 @@
+#include "FixedMedianFilter.h"
+#include "HampelFilter.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Synthetic slosh trace: calm, then driving (the surface oscillates by +/-25 mm and the
+// echo bounces off the waves in bursts of 1 to 4 spikes), then calm again
+struct SloshTrace {
+  std::vector<int> surface; // true echo distance, waves included
+  std::vector<int> measured;
+  std::vector<bool> spike;
+  static constexpr int CALM_END = 100;
+  static constexpr int SLOSH_END = 340;
+};
+
+static SloshTrace makeSloshTrace() {
+  SloshTrace trace;
+  unsigned int seed = 3;
+  int burst = 0;
+  for (int i = 0; i < 500; i++) {
+    seed = seed * 1103515245 + 12345;
+    const bool sloshing = i >= SloshTrace::CALM_END && i < SloshTrace::SLOSH_END;
+    const int wave = sloshing ? static_cast<int>(std::lround(25 * std::sin(2 * M_PI * i / 16))) : 0;
+    const int noise = static_cast<int>((seed >> 16) % 5) - 2;
+    if (sloshing && burst == 0 && (seed >> 8) % 20 == 0) {
+      burst = 1 + static_cast<int>((seed >> 12) % 4);
+    }
+    const bool spike = burst > 0;
+    burst = burst > 0 ? burst - 1 : 0;
+    trace.surface.push_back(480 + wave);
+    trace.measured.push_back(480 + wave + noise + (spike ? 250 : 0));
+    trace.spike.push_back(spike);
+  }
+  return trace;
+}
+
+// Largest distance between the output and the surface while sloshing
+static int worstSloshError(Filter &filter, const SloshTrace &trace) {
+  int worst = 0;
+  for (size_t i = 0; i < trace.measured.size(); i++) {
+    const int output = filter.apply(trace.measured[i]);
+    if (i >= SloshTrace::CALM_END && i < SloshTrace::SLOSH_END) {
+      worst = std::max(worst, std::abs(output - trace.surface[i]));
+    }
+  }
+  return worst;
+}
+
+TEST(HampelFilter, KeepsCalmNoise) {
+  HampelFilter filter(7, 15, 10);
+
+  for (int i = 0; i < 200; i++) {
+    const int sample = 480 + (i * 7) % 5 - 2;
+    EXPECT_EQ(filter.apply(sample), sample);
+  }
+  EXPECT_EQ(filter.getRejectedCount(), 0u);
+  EXPECT_FALSE(filter.inMotion());
+}
+
+TEST(HampelFilter, ReplacesASpikeWithTheMedian) {
+  HampelFilter filter(7, 15, 10);
+  for (int sample : {480, 481, 479, 480, 482, 480}) {
+    filter.apply(sample);
+  }
+
+  EXPECT_EQ(filter.apply(900), 480);
+  EXPECT_EQ(filter.getRejectedCount(), 1u);
+}
+
+TEST(HampelFilter, WindowSizesAreClampedToTheHistory) {
+  HampelFilter empty(0, -3, 10);
+  HampelFilter single(1, 1, 10);
+  HampelFilter oversized(50, 50, 10);
+  HampelFilter widest(HampelFilter::MAX_WINDOW, HampelFilter::MAX_WINDOW, 10);
+
+  for (int sample : {480, 481, 900, 479, 480, 300, 300, 482}) {
+    EXPECT_EQ(empty.apply(sample), single.apply(sample));
+    EXPECT_EQ(oversized.apply(sample), widest.apply(sample));
+  }
+}
+
+TEST(HampelFilter, AcceptsALevelJumpOnceItHolds) {
+  HampelFilter filter(7, 15, 10);
+  for (int i = 0; i < 20; i++) {
+    filter.apply(480);
+  }
+
+  // The jump itself looks like motion: it holds for half the wide window
+  int output = 0;
+  for (int i = 0; i < 8; i++) {
+    output = filter.apply(300);
+  }
+
+  EXPECT_EQ(output, 300);
+}
+
+TEST(HampelFilter, EntersMotionModeWhileSloshingAndLeavesAfter) {
+  const SloshTrace trace = makeSloshTrace();
+  HampelFilter filter(7, 15, 10);
+
+  bool movedWhileSloshing = false;
+  for (size_t i = 0; i < trace.measured.size(); i++) {
+    filter.apply(trace.measured[i]);
+    if (i < SloshTrace::CALM_END) {
+      ASSERT_FALSE(filter.inMotion()) << "sample " << i;
+    }
+    if (i == SloshTrace::SLOSH_END - 1) {
+      movedWhileSloshing = filter.inMotion();
+    }
+  }
+
+  EXPECT_TRUE(movedWhileSloshing);
+  EXPECT_FALSE(filter.inMotion());
+  EXPECT_EQ(filter.getMotionCount(), 1u);
+}
+
+TEST(HampelFilter, RejectsSpikeBurstsWhileSloshing) {
+  const SloshTrace trace = makeSloshTrace();
+  HampelFilter filter(7, 15, 10);
+
+  // A rejected sample takes the median, up to a wave amplitude away, never a 250 mm spike
+  EXPECT_LE(worstSloshError(filter, trace), 50);
+
+  int spikes = 0;
+  for (bool spike : trace.spike) {
+    spikes += spike ? 1 : 0;
+  }
+  EXPECT_GE(filter.getRejectedCount(), static_cast<unsigned long>(spikes));
+  EXPECT_GT(filter.getRejectedInMotionCount(), 0u);
+}
+
+TEST(HampelFilter, WideningTheWindowStopsBurstsTheNarrowOneLetsThrough) {
+  const SloshTrace trace = makeSloshTrace();
+  HampelFilter adaptive(7, 15, 10);
+  HampelFilter narrow(7, 7, 10);
+  FixedMedianFilter<5> median;
+
+  const int adaptiveError = worstSloshError(adaptive, trace);
+
+  EXPECT_GT(worstSloshError(narrow, trace), adaptiveError);
+  EXPECT_GT(worstSloshError(median, trace), adaptiveError);
+}
@@ -1,5 +1,8 @@
 #include "MedianFilter.h"
+#include "../CountingAllocator.h"
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <vector>
 
 TEST(MedianFilterTest, ReturnsValueImmediatelyForFirstApply) {
   MedianFilter filter(3);
@@ -37,4 +40,42 @@ TEST(MedianFilterTest, WindowSizeOneReturnsInput) {
   MedianFilter filter(1);
   int result = filter.apply(42);
   EXPECT_EQ(42, result);
-}
\ No newline at end of file
+}
+
+// The copy-and-sort filter the streaming one replaced, as the reference output
+static int sortedWindowMedian(const std::vector<int> &window) {
+  std::vector<int> sorted = window;
+  std::sort(sorted.begin(), sorted.end());
+  return sorted[sorted.size() / 2];
+}
+
+TEST(MedianFilterTest, MatchesSortedWindowOnRandomSamples) {
+  const int windowSizes[] = {1, 2, 5, 9, 10, 101};
+  for (int windowSize : windowSizes) {
+    MedianFilter filter(windowSize);
+    std::vector<int> window(windowSize, 0);
+    unsigned int seed = 12345;
+    for (int i = 0; i < 1000; i++) {
+      seed = seed * 1103515245 + 12345;
+      // Narrow range so the window holds duplicates
+      const int sample = static_cast<int>((seed >> 16) % 50);
+      if (i == 0) {
+        std::fill(window.begin(), window.end(), sample);
+      } else {
+        window[(i - 1) % windowSize] = sample;
+      }
+      ASSERT_EQ(filter.apply(sample), sortedWindowMedian(window)) << "window " << windowSize << ", sample " << i;
+    }
+  }
+}
+
+TEST(MedianFilterTest, ApplyDoesNotAllocate) {
+  MedianFilter filter(101);
+  filter.apply(0);
+
+  const size_t before = CountingAllocator::allocations();
+  for (int i = 0; i < 500; i++) {
+    filter.apply(i % 37);
+  }
+  EXPECT_EQ(CountingAllocator::allocations(), before);
+}
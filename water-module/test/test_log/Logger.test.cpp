@@ -2,7 +2,11 @@
 #include "../ArduinoMacroGuard.h"
 #include "../MockStream.h"
 #include "UltrasonicSensor.h"
+#include <atomic>
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 class LoggerTest : public ::testing::Test {
 protected:
@@ -13,6 +17,7 @@ TEST_F(LoggerTest, DebugLogsWhenLevelIsDebug) {
   Logger logger(mockStream, Logger::DEBUG);
 
   logger.debug("test message %d", 42);
+  logger.flush();
 
   std::string expected = "\n[DEBUG] test message 42";
   std::string actual(mockStream.output.begin(), mockStream.output.end());
@@ -23,6 +28,7 @@ TEST_F(LoggerTest, DebugDoesNotLogWhenLevelIsInfo) {
   Logger logger(mockStream, Logger::INFO);
 
   logger.debug("test message %d", 42);
+  logger.flush();
 
   EXPECT_TRUE(mockStream.output.empty());
 }
@@ -31,6 +37,7 @@ TEST_F(LoggerTest, InfoLogsWhenLevelIsInfo) {
   Logger logger(mockStream, Logger::INFO);
 
   logger.info("info message %s", "hello");
+  logger.flush();
 
   std::string expected = "\n[INFO] info message hello";
   std::string actual(mockStream.output.begin(), mockStream.output.end());
@@ -41,6 +48,7 @@ TEST_F(LoggerTest, InfoLogsWhenLevelIsDebug) {
   Logger logger(mockStream, Logger::DEBUG);
 
   logger.info("info message %s", "world");
+  logger.flush();
 
   std::string expected = "\n[INFO] info message world";
   std::string actual(mockStream.output.begin(), mockStream.output.end());
@@ -51,12 +59,131 @@ TEST_F(LoggerTest, SetLevelChangesLogging) {
   Logger logger(mockStream, Logger::INFO);
 
   logger.debug("should not log");
+  logger.flush();
   EXPECT_TRUE(mockStream.output.empty());
 
   logger.setLevel(Logger::DEBUG);
   logger.debug("should log now %d", 1);
+  logger.flush();
 
   std::string expected = "\n[DEBUG] should log now 1";
   std::string actual(mockStream.output.begin(), mockStream.output.end());
   EXPECT_EQ(expected, actual);
-}
\ No newline at end of file
+}
+
+TEST_F(LoggerTest, LinesWaitForDrain) {
+  Logger logger(mockStream, Logger::INFO);
+
+  logger.info("queued %d", 1);
+  EXPECT_TRUE(mockStream.output.empty());
+
+  logger.drain(SIZE_MAX);
+  std::string actual(mockStream.output.begin(), mockStream.output.end());
+  EXPECT_EQ(actual, "\n[INFO] queued 1");
+}
+
+TEST_F(LoggerTest, DrainStopsAtTheByteBudgetAndResumes) {
+  Logger logger(mockStream, Logger::INFO);
+  logger.info("first");
+  logger.info("second");
+
+  logger.drain(10);
+  EXPECT_EQ(std::string(mockStream.output.begin(), mockStream.output.end()), "\n[INFO] fi");
+
+  logger.drain(SIZE_MAX);
+  EXPECT_EQ(std::string(mockStream.output.begin(), mockStream.output.end()), "\n[INFO] first\n[INFO] second");
+}
+
+TEST_F(LoggerTest, TextArgumentsAreCopiedWhenLogged) {
+  Logger logger(mockStream, Logger::INFO);
+  std::string name = "grey_tank";
+
+  logger.info("%s: %s", name.c_str(), "ready");
+  name = "overwritten";
+  logger.flush();
+
+  EXPECT_EQ(std::string(mockStream.output.begin(), mockStream.output.end()), "\n[INFO] grey_tank: ready");
+}
+
+TEST_F(LoggerTest, FormatsLikePrintf) {
+  Logger logger(mockStream, Logger::DEBUG);
+  const uint8_t address[] = {0x28, 0xFF, 0x0A};
+  const unsigned long rejected = 4000000000UL;
+  const float temperature = 21.25f;
+
+  logger.debug("PID: temp=%.1f, out=%d, %5.2f%%", temperature, -42, 3.14159);
+  logger.info("probe %d: %02X%02X%02X", 1, address[0], address[1], address[2]);
+  logger.warn("%lu rejected, %u left, %c%s", rejected, 7u, 'o', "k");
+  logger.flush();
+
+  EXPECT_EQ(std::string(mockStream.output.begin(), mockStream.output.end()),
+            "\n[DEBUG] PID: temp=21.2, out=-42,  3.14%"
+            "\n[INFO] probe 1: 28FF0A"
+            "\n[WARN] 4000000000 rejected, 7 left, ok");
+}
+
+TEST_F(LoggerTest, FullQueueDropsAndReportsOverflow) {
+  Logger logger(mockStream, Logger::INFO);
+
+  for (size_t i = 0; i < Logger::QUEUE_SIZE + 3; i++) {
+    logger.info("line %d", static_cast<int>(i));
+  }
+  EXPECT_EQ(logger.getDroppedCount(), 3u);
+
+  logger.flush();
+  const std::string actual(mockStream.output.begin(), mockStream.output.end());
+  // Reported in order: after the lines queued before the drops
+  EXPECT_EQ(actual.find("\n[INFO] line 0"), 0u);
+  const std::string lastQueued = "\n[INFO] line 31";
+  EXPECT_EQ(actual.find("\n[WARN] 3 log lines dropped"), actual.find(lastQueued) + lastQueued.size());
+  EXPECT_EQ(actual.find("\n[INFO] line 32"), std::string::npos);
+
+  // The ring is free again once drained
+  mockStream.reset();
+  logger.info("after");
+  logger.flush();
+  EXPECT_EQ(std::string(mockStream.output.begin(), mockStream.output.end()), "\n[INFO] after");
+}
+
+TEST_F(LoggerTest, ConcurrentProducersLoseNoLine) {
+  Logger logger(mockStream, Logger::INFO);
+  const int perThread = 1000;
+  std::atomic<bool> done{false};
+  std::vector<std::thread> producers;
+
+  for (int t = 0; t < 3; t++) {
+    producers.emplace_back([&logger, t]() {
+      for (int i = 0; i < perThread; i++) {
+        logger.info("%d", t);
+      }
+    });
+  }
+  std::thread consumer([&]() {
+    while (!done.load()) {
+      logger.drain(SIZE_MAX);
+    }
+  });
+  for (std::thread &producer : producers) {
+    producer.join();
+  }
+  done = true;
+  consumer.join();
+  logger.flush();
+
+  const std::string actual(mockStream.output.begin(), mockStream.output.end());
+  size_t lines = 0;
+  for (size_t pos = actual.find("[INFO] "); pos != std::string::npos; pos = actual.find("[INFO] ", pos + 1)) {
+    lines++;
+  }
+  EXPECT_EQ(lines + logger.getDroppedCount(), 3u * perThread);
+}
+
+TEST_F(LoggerTest, WarnLevelFiltersInfoButNotWarn) {
+  Logger logger(mockStream, Logger::WARN);
+
+  logger.info("filtered");
+  logger.warn("kept %d", 3);
+  logger.flush();
+
+  EXPECT_EQ(std::string(mockStream.output.begin(), mockStream.output.end()), "\n[WARN] kept 3");
+}
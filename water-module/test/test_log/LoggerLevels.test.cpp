@@ -0,0 +1,58 @@
+// Built as if from a release build: DEBUG compiled out
+#undef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 1
+#include "../ArduinoMacroGuard.h"
+#include "../MockStream.h"
+#include "Logger.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+int evaluations = 0;
+
+float expensive(float value) {
+  evaluations++;
+  return value * 2;
+}
+} // namespace
+
+class LoggerLevelsTest : public ::testing::Test {
+protected:
+  MockStream mockStream;
+  void SetUp() override { evaluations = 0; }
+  std::string output() const { return std::string(mockStream.output.begin(), mockStream.output.end()); }
+};
+
+TEST_F(LoggerLevelsTest, CompiledOutLevelEvaluatesNothing) {
+  Logger logger(mockStream, Logger::DEBUG);
+
+  for (int i = 0; i < 100; i++) {
+    LOG_DEBUG(&logger, "PID: temp=%.1f, sp=%.1f", expensive(21.5f), expensive(20.0f));
+  }
+  logger.flush();
+
+  EXPECT_EQ(evaluations, 0);
+  EXPECT_EQ(logger.getDroppedCount(), 0u);
+  EXPECT_TRUE(output().empty());
+}
+
+TEST_F(LoggerLevelsTest, CompiledInLevelsStillLog) {
+  Logger logger(mockStream, Logger::DEBUG);
+
+  LOG_INFO(&logger, "temp=%.1f", expensive(10.5f));
+  LOG_WARN(&logger, "stale");
+  logger.flush();
+
+  EXPECT_EQ(evaluations, 1);
+  EXPECT_EQ(output(), "\n[INFO] temp=21.0\n[WARN] stale");
+}
+
+TEST_F(LoggerLevelsTest, RuntimeLevelFiltersWarnIndependently) {
+  Logger logger(mockStream, Logger::WARN);
+
+  LOG_INFO(&logger, "filtered");
+  LOG_WARN(&logger, "kept");
+  logger.flush();
+
+  EXPECT_EQ(output(), "\n[WARN] kept");
+}
@@ -0,0 +1,51 @@
+#include "Os.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+
+namespace {
+// Shared with the started task, which counts until asked to stop
+struct Counter {
+  std::atomic<bool> started{false};
+  std::atomic<int> ticks{0};
+  std::atomic<bool> stop{false};
+  std::atomic<bool> stopped{false};
+};
+
+void countUntilStopped(void *arg) {
+  Counter *counter = static_cast<Counter *>(arg);
+  counter->started.store(true);
+  while (!counter->stop.load()) {
+    counter->ticks++;
+    os::sleepMs(1);
+  }
+  counter->stopped.store(true);
+}
+} // namespace
+
+TEST(Os, StartedTaskRunsAlongsideTheCaller) {
+  Counter counter;
+
+  ASSERT_TRUE(os::startTask("counter", &countUntilStopped, &counter, os::RADIO_CORE, 4096, 1));
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (counter.ticks.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+    os::sleepMs(1);
+  }
+  EXPECT_TRUE(counter.started.load());
+  EXPECT_GE(counter.ticks.load(), 3);
+
+  // The task uses counter until it reports it left its loop
+  counter.stop.store(true);
+  while (!counter.stopped.load()) {
+    os::sleepMs(1);
+  }
+}
+
+TEST(Os, SleepBlocksAtLeastTheDelay) {
+  const auto start = std::chrono::steady_clock::now();
+
+  os::sleepMs(20);
+
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
@@ -0,0 +1,89 @@
+#include "SpscQueue.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+
+TEST(SpscQueue, FifoUntilFull) {
+  SpscQueue<int, 4> queue;
+
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(queue.push(i));
+  }
+  EXPECT_FALSE(queue.push(4));
+  EXPECT_EQ(queue.claim(), nullptr);
+  EXPECT_EQ(queue.size(), 4u);
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(*queue.front(), i);
+    queue.pop();
+  }
+  EXPECT_EQ(queue.front(), nullptr);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueue, ClaimedSlotIsInvisibleUntilPublished) {
+  SpscQueue<int, 2> queue;
+
+  *queue.claim() = 7;
+  EXPECT_EQ(queue.front(), nullptr);
+
+  queue.publish();
+  ASSERT_NE(queue.front(), nullptr);
+  EXPECT_EQ(*queue.front(), 7);
+}
+
+TEST(SpscQueue, WrapsAround) {
+  SpscQueue<int, 2> queue;
+
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(queue.push(i));
+    EXPECT_EQ(*queue.front(), i);
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+// Elements larger than a word must arrive whole: the consumer never sees a slot half written
+TEST(SpscQueue, TwoThreadsLoseAndTearNothing) {
+  struct Message {
+    int sequence;
+    int copies[15];
+  };
+  SpscQueue<Message, 8> queue;
+  const int count = 100000;
+
+  std::thread producer([&queue]() {
+    for (int i = 0; i < count; i++) {
+      Message *slot;
+      while ((slot = queue.claim()) == nullptr) {
+        std::this_thread::yield();
+      }
+      slot->sequence = i;
+      for (int &copy : slot->copies) {
+        copy = i;
+      }
+      queue.publish();
+    }
+  });
+
+  int expected = 0;
+  bool torn = false;
+  while (expected < count) {
+    const Message *message = queue.front();
+    if (message == nullptr) {
+      std::this_thread::yield();
+      continue;
+    }
+    torn = torn || message->sequence != expected;
+    for (int copy : message->copies) {
+      torn = torn || copy != expected;
+    }
+    queue.pop();
+    expected++;
+  }
+  producer.join();
+
+  EXPECT_FALSE(torn);
+  EXPECT_TRUE(queue.empty());
+}
@@ -1,5 +1,6 @@
 #include "AdminProtocol.h"
 #include "../FakeSettings.h"
+#include "../ReplyTo.h"
 #include <gtest/gtest.h>
 #include <string>
 
@@ -8,7 +9,7 @@ TEST(AdminProtocol, PinWritePersistsAndRespondsOk) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("PIN:123456"), "OK");
+  EXPECT_EQ(replyTo(p, "PIN:123456"), "OK");
   EXPECT_EQ(s.int_values["pin_code"], 123456);
 }
 
@@ -17,8 +18,8 @@ TEST(AdminProtocol, PinWriteRejectsWrongLength) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("PIN:12345"), "ERR_PIN_LEN");
-  EXPECT_EQ(p.handle("PIN:1234567"), "ERR_PIN_LEN");
+  EXPECT_EQ(replyTo(p, "PIN:12345"), "ERR_PIN_LEN");
+  EXPECT_EQ(replyTo(p, "PIN:1234567"), "ERR_PIN_LEN");
 }
 
 TEST(AdminProtocol, PinWriteRejectsNonNumeric) {
@@ -26,7 +27,7 @@ TEST(AdminProtocol, PinWriteRejectsNonNumeric) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("PIN:12ab56"), "ERR_PIN_NUM");
+  EXPECT_EQ(replyTo(p, "PIN:12ab56"), "ERR_PIN_NUM");
 }
 
 TEST(AdminProtocol, NameWritePersistsAndRespondsOk) {
@@ -34,7 +35,7 @@ TEST(AdminProtocol, NameWritePersistsAndRespondsOk) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("NAME:My_Water-Tank 1"), "OK");
+  EXPECT_EQ(replyTo(p, "NAME:My_Water-Tank 1"), "OK");
   EXPECT_EQ(s.str_values["device_name"], "My_Water-Tank 1");
 }
 
@@ -43,8 +44,8 @@ TEST(AdminProtocol, NameWriteRejectsEmptyAndTooLong) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("NAME:"), "ERR_NAME_LEN");
-  EXPECT_EQ(p.handle("NAME:123456789012345678901"), "ERR_NAME_LEN");
+  EXPECT_EQ(replyTo(p, "NAME:"), "ERR_NAME_LEN");
+  EXPECT_EQ(replyTo(p, "NAME:123456789012345678901"), "ERR_NAME_LEN");
 }
 
 TEST(AdminProtocol, NameWriteRejectsInvalidChars) {
@@ -52,7 +53,7 @@ TEST(AdminProtocol, NameWriteRejectsInvalidChars) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("NAME:Bad!Name"), "ERR_NAME_CHARS");
+  EXPECT_EQ(replyTo(p, "NAME:Bad!Name"), "ERR_NAME_CHARS");
 }
 
 TEST(AdminProtocol, IdentityWritePersistsBothAndRespondsOkOnce) {
@@ -60,18 +61,28 @@ TEST(AdminProtocol, IdentityWritePersistsBothAndRespondsOkOnce) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("ID:NAME=My_Water-Tank 1;PIN=123456"), "OK");
+  EXPECT_EQ(replyTo(p, "ID:NAME=My_Water-Tank 1;PIN=123456"), "OK");
   EXPECT_EQ(s.str_values["device_name"], "My_Water-Tank 1");
   EXPECT_EQ(s.int_values["pin_code"], 123456);
 }
 
+TEST(AdminProtocol, IdentityWritePersistsNameAndPinInOneCommit) {
+  FakeSettings s;
+  AdminSettings adminSettings(&s);
+  AdminProtocol p(&adminSettings);
+
+  EXPECT_EQ(replyTo(p, "ID:NAME=Van;PIN=123456"), "OK");
+  EXPECT_EQ(s.commits, 1);
+  EXPECT_EQ(s.transactionDepth, 0);
+}
+
 TEST(AdminProtocol, IdentityWriteRejectsInvalidName) {
   FakeSettings s;
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("ID:NAME=;PIN=123456"), "ERR_NAME_LEN");
-  EXPECT_EQ(p.handle("ID:NAME=Bad!Name;PIN=123456"), "ERR_NAME_CHARS");
+  EXPECT_EQ(replyTo(p, "ID:NAME=;PIN=123456"), "ERR_NAME_LEN");
+  EXPECT_EQ(replyTo(p, "ID:NAME=Bad!Name;PIN=123456"), "ERR_NAME_CHARS");
 }
 
 TEST(AdminProtocol, IdentityWriteRejectsInvalidPin) {
@@ -79,8 +90,8 @@ TEST(AdminProtocol, IdentityWriteRejectsInvalidPin) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("ID:NAME=Van;PIN=12345"), "ERR_PIN_LEN");
-  EXPECT_EQ(p.handle("ID:NAME=Van;PIN=12ab56"), "ERR_PIN_NUM");
+  EXPECT_EQ(replyTo(p, "ID:NAME=Van;PIN=12345"), "ERR_PIN_LEN");
+  EXPECT_EQ(replyTo(p, "ID:NAME=Van;PIN=12ab56"), "ERR_PIN_NUM");
 }
 
 TEST(AdminProtocol, IdentityWriteRejectsMalformedFrame) {
@@ -88,9 +99,9 @@ TEST(AdminProtocol, IdentityWriteRejectsMalformedFrame) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("ID:"), "ERR_ID_FMT");
-  EXPECT_EQ(p.handle("ID:NAME=Van"), "ERR_ID_FMT");
-  EXPECT_EQ(p.handle("ID:PIN=123456"), "ERR_ID_FMT");
+  EXPECT_EQ(replyTo(p, "ID:"), "ERR_ID_FMT");
+  EXPECT_EQ(replyTo(p, "ID:NAME=Van"), "ERR_ID_FMT");
+  EXPECT_EQ(replyTo(p, "ID:PIN=123456"), "ERR_ID_FMT");
 }
 
 // The name ends at the FIRST ";PIN=": splitting at the last would hand the
@@ -100,7 +111,7 @@ TEST(AdminProtocol, IdentityWriteSplitsOnTheFirstPinSeparator) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("ID:NAME=Van;PIN=x;PIN=123456"), "ERR_PIN_LEN");
+  EXPECT_EQ(replyTo(p, "ID:NAME=Van;PIN=x;PIN=123456"), "ERR_PIN_LEN");
   EXPECT_EQ(s.str_values.count("device_name"), 0u);
   EXPECT_EQ(s.int_values.count("pin_code"), 0u);
 }
@@ -110,11 +121,11 @@ TEST(AdminProtocol, IdentityWritePersistsNothingWhenOneFieldIsRejected) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("ID:NAME=Van;PIN=12345"), "ERR_PIN_LEN");
+  EXPECT_EQ(replyTo(p, "ID:NAME=Van;PIN=12345"), "ERR_PIN_LEN");
   EXPECT_EQ(s.str_values.count("device_name"), 0u);
   EXPECT_EQ(s.int_values.count("pin_code"), 0u);
 
-  EXPECT_EQ(p.handle("ID:NAME=Bad!Name;PIN=123456"), "ERR_NAME_CHARS");
+  EXPECT_EQ(replyTo(p, "ID:NAME=Bad!Name;PIN=123456"), "ERR_NAME_CHARS");
   EXPECT_EQ(s.str_values.count("device_name"), 0u);
   EXPECT_EQ(s.int_values.count("pin_code"), 0u);
 }
@@ -124,6 +135,6 @@ TEST(AdminProtocol, UnknownCommandReturnsErrUnknown) {
   AdminSettings adminSettings(&s);
   AdminProtocol p(&adminSettings);
 
-  EXPECT_EQ(p.handle("PING"), "ERR_UNKNOWN_CMD");
+  EXPECT_EQ(replyTo(p, "PING"), "ERR_UNKNOWN_CMD");
 }
 
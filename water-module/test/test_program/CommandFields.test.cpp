@@ -0,0 +1,109 @@
+#include "CommandFields.h"
+#include "../CountingAllocator.h"
+#include "../FakeSettings.h"
+#include "AdminProtocol.h"
+#include "TankCfgProtocol.h"
+#include "TelemetryProtocol.h"
+#include "ValveCfgProtocol.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(CommandFields, FindsValuesByWholeKeyInAnyOrder) {
+  const CommandFields fields("HB=30;DB=5;B=7");
+
+  EXPECT_EQ(fields.get("DB"), "5");
+  EXPECT_EQ(fields.get("HB"), "30");
+  EXPECT_EQ(fields.get("B"), "7");
+  EXPECT_TRUE(fields.get("H").empty());
+  EXPECT_TRUE(fields.get("X").empty());
+}
+
+TEST(CommandFields, EmptyOrMissingValueIsMissing) {
+  const CommandFields fields("V=;H=10");
+  int value = -1;
+
+  EXPECT_EQ(fields.getInt("V", 0, 100, value), ParseStatus::MISSING);
+  EXPECT_EQ(fields.getInt("T", 0, 100, value), ParseStatus::MISSING);
+  EXPECT_EQ(value, -1);
+}
+
+TEST(CommandFields, ValuesViewTheReceivedString) {
+  const std::string rx = "KP=120;KI=30";
+  const CommandFields fields(rx);
+
+  EXPECT_EQ(fields.get("KI").data(), rx.data() + 10);
+}
+
+TEST(ParseInt, AcceptsDigitsWithinBounds) {
+  int value = 0;
+
+  EXPECT_EQ(parseInt("0", 0, 10, value), ParseStatus::OK);
+  EXPECT_EQ(value, 0);
+  EXPECT_EQ(parseInt("007", 0, 10, value), ParseStatus::OK);
+  EXPECT_EQ(value, 7);
+  EXPECT_EQ(parseInt("2147483647", 0, 2147483647, value), ParseStatus::OK);
+  EXPECT_EQ(value, 2147483647);
+  EXPECT_EQ(parseInt("-5", -10, 10, value), ParseStatus::OK);
+  EXPECT_EQ(value, -5);
+}
+
+TEST(ParseInt, RejectsAnythingButDigits) {
+  int value = 42;
+
+  EXPECT_EQ(parseInt("", 0, 10, value), ParseStatus::MISSING);
+  EXPECT_EQ(parseInt("-1", 0, 10, value), ParseStatus::NOT_A_NUMBER);
+  EXPECT_EQ(parseInt("+1", 0, 10, value), ParseStatus::NOT_A_NUMBER);
+  EXPECT_EQ(parseInt(" 1", 0, 10, value), ParseStatus::NOT_A_NUMBER);
+  EXPECT_EQ(parseInt("1 ", 0, 10, value), ParseStatus::NOT_A_NUMBER);
+  EXPECT_EQ(parseInt("1a", 0, 10, value), ParseStatus::NOT_A_NUMBER);
+  EXPECT_EQ(parseInt("2147483648", 0, 10, value), ParseStatus::NOT_A_NUMBER);
+  EXPECT_EQ(parseInt("99999999999999999999", 0, 10, value), ParseStatus::NOT_A_NUMBER);
+  EXPECT_EQ(value, 42);
+}
+
+TEST(ParseInt, ReportsBoundsSeparately) {
+  int value = 42;
+
+  EXPECT_EQ(parseInt("11", 0, 10, value), ParseStatus::OUT_OF_RANGE);
+  EXPECT_EQ(parseInt("0", 1, 10, value), ParseStatus::OUT_OF_RANGE);
+  EXPECT_EQ(value, 42);
+}
+
+// Settled keys: FakeSettings overwrites existing map entries without allocating
+TEST(CommandFields, ProtocolCommandsDoNotAllocate) {
+  FakeSettings settings;
+  TankSettings tankSettings(&settings, "grey");
+  TankCfgProtocol tank(&tankSettings);
+  ValveSettings valveSettings(&settings, "valve");
+  ValveCfgProtocol valve(&valveSettings);
+  TelemetrySettings telemetrySettings(&settings, "grey");
+  TelemetryGate gate(1);
+  TelemetryProtocol telemetry(&telemetrySettings, &gate);
+  const char *commands[] = {"CFG:V=120;H=480",          "CFG:H=480;V=abc",  "CFG:V=120",
+                            "CFG?",                     "CFG:V=999999;H=1", "TBL:0:0,abc:10",
+                            "TBL:0:0,20000:10",         "TBL?",             "TLM:DB=5;HB=30",
+                            "TLM:DB=99999999999;HB=30", "TLM?",             "NOPE"};
+  CommandReply reply;
+  for (const char *command : commands) {
+    tank.handle(command, reply);
+    telemetry.handle(command, reply);
+    reply.clear();
+  }
+  valve.handle("CFG:T=30", reply);
+
+  const int before = CountingAllocator::allocations();
+  for (const char *command : commands) {
+    reply.clear();
+    tank.handle(command, reply);
+    reply.clear();
+    telemetry.handle(command, reply);
+  }
+  reply.clear();
+  valve.handle("CFG:T=30", reply);
+  reply.clear();
+  valve.handle("CFG:T=0", reply);
+  reply.clear();
+  valve.handle("CFG?", reply);
+
+  EXPECT_EQ(CountingAllocator::allocations(), before);
+}
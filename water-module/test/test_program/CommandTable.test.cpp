@@ -0,0 +1,101 @@
+#include "CommandTable.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+class Recorder {
+public:
+  std::string last;
+  int values[CommandArgs::MAX_FIELDS] = {};
+
+  void read(const CommandArgs &args, CommandReply &reply) {
+    last = std::string(args.command);
+    reply.append("READ");
+  }
+  void write(const CommandArgs &args, CommandReply &reply) {
+    last = std::string(args.body);
+    std::copy(args.values, args.values + CommandArgs::MAX_FIELDS, values);
+    reply.append("OK");
+  }
+  void raw(const CommandArgs &args, CommandReply &reply) {
+    last = std::string(args.body);
+    reply.append("RAW");
+  }
+};
+
+constexpr CommandErrors ERRORS = {"ERR_FMT", "ERR_NUM", "ERR_RANGE"};
+
+// 20 slots (the default) puts two of these verbs together
+constexpr CommandTable<Recorder, 5, 21> COMMANDS({
+    {"GET?", &Recorder::read},
+    {"SET:", &Recorder::write, ERRORS, {{"A", 1, 10}, {"B", 0, 5}}},
+    {"N:", &Recorder::write, ERRORS, {{"", 0, 100}}},
+    {"RAW:", &Recorder::raw},
+    {"GO", &Recorder::read},
+});
+static_assert(COMMANDS.isPerfect(), "Two test verbs share a hash slot");
+
+template <typename Table>
+std::string dispatch(const Table &table, Recorder &recorder, std::string_view rx, const char *unknown) {
+  CommandReply reply;
+  table.dispatch(recorder, rx, unknown, reply);
+  return std::string(reply.view());
+}
+} // namespace
+
+TEST(CommandTable, DispatchesByVerb) {
+  Recorder recorder;
+
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "GET?", "UNKNOWN"), "READ");
+  EXPECT_EQ(recorder.last, "GET?");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "GO", "UNKNOWN"), "READ");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "RAW:a:b", "UNKNOWN"), "RAW");
+  EXPECT_EQ(recorder.last, "a:b");
+}
+
+TEST(CommandTable, UnknownOrPartialVerbsGetTheUnknownResponse) {
+  Recorder recorder;
+
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "", "UNKNOWN"), "UNKNOWN");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "GET", "UNKNOWN"), "UNKNOWN");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "GO!", "UNKNOWN"), "UNKNOWN");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "GET?:", "UNKNOWN"), "UNKNOWN");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "XSET:A=1;B=1", ""), "");
+  EXPECT_TRUE(recorder.last.empty());
+}
+
+TEST(CommandTable, PassesValidatedFieldsInDeclarationOrder) {
+  Recorder recorder;
+
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "SET:B=5;A=10", "UNKNOWN"), "OK");
+  EXPECT_EQ(recorder.values[0], 10);
+  EXPECT_EQ(recorder.values[1], 5);
+}
+
+TEST(CommandTable, ReportsTheWorstFieldError) {
+  Recorder recorder;
+
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "SET:A=11;B=1", "UNKNOWN"), "ERR_RANGE");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "SET:A=11;B=x", "UNKNOWN"), "ERR_NUM");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "SET:A=x", "UNKNOWN"), "ERR_FMT");
+  // The handler never sees rejected values
+  EXPECT_TRUE(recorder.last.empty());
+}
+
+TEST(CommandTable, WholeBodyField) {
+  Recorder recorder;
+
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "N:42", "UNKNOWN"), "OK");
+  EXPECT_EQ(recorder.values[0], 42);
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "N:101", "UNKNOWN"), "ERR_RANGE");
+  EXPECT_EQ(dispatch(COMMANDS, recorder, "N:", "UNKNOWN"), "ERR_FMT");
+}
+
+TEST(CommandTable, ReportsCollidingVerbs) {
+  constexpr CommandTable<Recorder, 2, 1> colliding({{"A", &Recorder::read}, {"B", &Recorder::read}});
+  Recorder recorder;
+
+  EXPECT_FALSE(colliding.isPerfect());
+  EXPECT_EQ(dispatch(colliding, recorder, "A", "UNKNOWN"), "READ");
+}
@@ -0,0 +1,36 @@
+#include "Deferred.h"
+#include <gtest/gtest.h>
+
+namespace {
+struct Component {
+  static int constructions;
+  int value;
+  Component *peer;
+
+  Component(int value, Component *peer) : value(value), peer(peer) { constructions++; }
+};
+int Component::constructions = 0;
+} // namespace
+
+TEST(Deferred, EmptyUntilEmplaced) {
+  const int before = Component::constructions;
+  Deferred<Component> slot;
+
+  EXPECT_EQ(slot.get(), nullptr);
+  EXPECT_EQ(Component::constructions, before);
+}
+
+TEST(Deferred, ConstructsInItsOwnStorage) {
+  Deferred<Component> first;
+  Deferred<Component> second;
+
+  Component &built = first.emplace(7, nullptr);
+  second.emplace(8, first.get());
+
+  EXPECT_EQ(&built, first.get());
+  EXPECT_GE(reinterpret_cast<const char *>(first.get()), reinterpret_cast<const char *>(&first));
+  EXPECT_LT(reinterpret_cast<const char *>(first.get()), reinterpret_cast<const char *>(&first) + sizeof(first));
+  EXPECT_EQ(first->value, 7);
+  EXPECT_EQ(second->peer, &built);
+  EXPECT_EQ((*second).value, 8);
+}
@@ -1,5 +1,6 @@
 #include "TankCfgProtocol.h"
 #include "../FakeSettings.h"
+#include "../ReplyTo.h"
 #include <gtest/gtest.h>
 #include <string>
 
@@ -10,7 +11,7 @@ TEST(TankCfgProtocol, CfgQueryRespondsWithCurrentValues) {
 
   TankSettings tankSettings(&s, std::string("clean"));
   TankCfgProtocol p(&tankSettings);
-  EXPECT_EQ(p.handle("CFG?"), "CFG:V=150;H=900");
+  EXPECT_EQ(replyTo(p, "CFG?"), "CFG:V=150;H=900");
 }
 
 TEST(TankCfgProtocol, CfgWritePersistsAndRespondsOk) {
@@ -18,18 +19,28 @@ TEST(TankCfgProtocol, CfgWritePersistsAndRespondsOk) {
   TankSettings tankSettings(&s, std::string("grey"));
   TankCfgProtocol p(&tankSettings);
 
-  EXPECT_EQ(p.handle("CFG:V=123;H=456"), "OK");
+  EXPECT_EQ(replyTo(p, "CFG:V=123;H=456"), "OK");
   EXPECT_EQ(s.int_values["grey_v_l"], 123);
   EXPECT_EQ(s.int_values["grey_h_mm"], 456);
 }
 
+TEST(TankCfgProtocol, CfgWritePersistsVolumeAndHeightInOneCommit) {
+  FakeSettings s;
+  TankSettings tankSettings(&s, std::string("grey"));
+  TankCfgProtocol p(&tankSettings);
+
+  EXPECT_EQ(replyTo(p, "CFG:V=123;H=456"), "OK");
+  EXPECT_EQ(s.commits, 1);
+  EXPECT_EQ(s.transactionDepth, 0);
+}
+
 TEST(TankCfgProtocol, CfgWriteRejectsMissingFields) {
   FakeSettings s;
   TankSettings tankSettings(&s, std::string("clean"));
   TankCfgProtocol p(&tankSettings);
 
-  EXPECT_EQ(p.handle("CFG:V=100"), "ERR_CFG_FMT");
-  EXPECT_EQ(p.handle("CFG:H=200"), "ERR_CFG_FMT");
+  EXPECT_EQ(replyTo(p, "CFG:V=100"), "ERR_CFG_FMT");
+  EXPECT_EQ(replyTo(p, "CFG:H=200"), "ERR_CFG_FMT");
 }
 
 TEST(TankCfgProtocol, CfgWriteRejectsNonNumeric) {
@@ -37,8 +48,8 @@ TEST(TankCfgProtocol, CfgWriteRejectsNonNumeric) {
   TankSettings tankSettings(&s, std::string("clean"));
   TankCfgProtocol p(&tankSettings);
 
-  EXPECT_EQ(p.handle("CFG:V=abc;H=100"), "ERR_CFG_NUM");
-  EXPECT_EQ(p.handle("CFG:V=100;H=-1"), "ERR_CFG_NUM");
+  EXPECT_EQ(replyTo(p, "CFG:V=abc;H=100"), "ERR_CFG_NUM");
+  EXPECT_EQ(replyTo(p, "CFG:V=100;H=-1"), "ERR_CFG_NUM");
 }
 
 TEST(TankCfgProtocol, CfgWriteRejectsOutOfRange) {
@@ -46,10 +57,10 @@ TEST(TankCfgProtocol, CfgWriteRejectsOutOfRange) {
   TankSettings tankSettings(&s, std::string("clean"));
   TankCfgProtocol p(&tankSettings);
 
-  EXPECT_EQ(p.handle("CFG:V=0;H=100"), "ERR_CFG_RANGE");
-  EXPECT_EQ(p.handle("CFG:V=100;H=0"), "ERR_CFG_RANGE");
-  EXPECT_EQ(p.handle("CFG:V=999999;H=100"), "ERR_CFG_RANGE");
-  EXPECT_EQ(p.handle("CFG:V=100;H=999999"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(p, "CFG:V=0;H=100"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(p, "CFG:V=100;H=0"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(p, "CFG:V=999999;H=100"), "ERR_CFG_RANGE");
+  EXPECT_EQ(replyTo(p, "CFG:V=100;H=999999"), "ERR_CFG_RANGE");
 }
 
 TEST(TankCfgProtocol, UnknownCommandReturnsErrUnknown) {
@@ -57,5 +68,92 @@ TEST(TankCfgProtocol, UnknownCommandReturnsErrUnknown) {
   TankSettings tankSettings(&s, std::string("clean"));
   TankCfgProtocol p(&tankSettings);
 
-  EXPECT_EQ(p.handle("PING"), "ERR_UNKNOWN_CMD");
+  EXPECT_EQ(replyTo(p, "PING"), "ERR_UNKNOWN_CMD");
+}
+
+TEST(TankCfgProtocol, TblQueryWithoutTableRespondsNone) {
+  FakeSettings s;
+  TankSettings tankSettings(&s, std::string("clean"));
+  TankCfgProtocol p(&tankSettings);
+
+  EXPECT_EQ(replyTo(p, "TBL?"), "TBL:NONE");
+}
+
+TEST(TankCfgProtocol, TblWritePersistsAndReloadsGeometry) {
+  FakeSettings s;
+  s.int_values["grey_v_l"] = 100;
+  s.int_values["grey_h_mm"] = 400;
+  TankSettings tankSettings(&s, std::string("grey"));
+  TankGeometry geometry;
+  tankSettings.loadGeometry(geometry);
+  TankCfgProtocol p(&tankSettings, &geometry);
+
+  EXPECT_EQ(replyTo(p, "TBL:0:0,300:30,400:60"), "OK");
+  EXPECT_EQ(s.str_values["grey_tbl"], "00000000012c001e0190003c");
+  EXPECT_EQ(replyTo(p, "TBL?"), "TBL:0:0,300:30,400:60");
+  EXPECT_TRUE(geometry.hasTable());
+  EXPECT_EQ(geometry.deciLiters(350), 450);
+}
+
+TEST(TankCfgProtocol, TblClearFallsBackToBox) {
+  FakeSettings s;
+  s.int_values["grey_v_l"] = 100;
+  s.int_values["grey_h_mm"] = 400;
+  TankSettings tankSettings(&s, std::string("grey"));
+  TankGeometry geometry;
+  TankCfgProtocol p(&tankSettings, &geometry);
+  ASSERT_EQ(replyTo(p, "TBL:0:0,300:30,400:60"), "OK");
+
+  EXPECT_EQ(replyTo(p, "TBL:CLR"), "OK");
+  EXPECT_EQ(replyTo(p, "TBL?"), "TBL:NONE");
+  EXPECT_FALSE(geometry.hasTable());
+  EXPECT_EQ(geometry.deciLiters(200), 500);
+}
+
+TEST(TankCfgProtocol, CfgWriteReloadsGeometry) {
+  FakeSettings s;
+  TankSettings tankSettings(&s, std::string("grey"));
+  TankGeometry geometry;
+  TankCfgProtocol p(&tankSettings, &geometry);
+
+  EXPECT_EQ(replyTo(p, "CFG:V=200;H=800"), "OK");
+  EXPECT_EQ(geometry.levelMm(0), 800);
+  EXPECT_EQ(geometry.deciLiters(400), 1000);
+}
+
+TEST(TankCfgProtocol, TblWriteRejectsBadTables) {
+  FakeSettings s;
+  TankSettings tankSettings(&s, std::string("clean"));
+  TankCfgProtocol p(&tankSettings);
+
+  EXPECT_EQ(replyTo(p, "TBL:"), "ERR_TBL_FMT");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,"), "ERR_TBL_FMT");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,100"), "ERR_TBL_FMT");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,1:1,2:2,3:3,4:4,5:5,6:6,7:7,8:8,9:9,10:10"), "ERR_TBL_FMT");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,abc:10"), "ERR_TBL_NUM");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,100:-10"), "ERR_TBL_NUM");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,20000:10"), "ERR_TBL_RANGE");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,100:6000"), "ERR_TBL_RANGE");
+  EXPECT_EQ(replyTo(p, "TBL:0:0"), "ERR_TBL_RANGE");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,200:20,100:30"), "ERR_TBL_RANGE");
+  EXPECT_EQ(replyTo(p, "TBL:0:0,100:20,200:10"), "ERR_TBL_RANGE");
+  EXPECT_TRUE(s.str_values.empty());
+}
+
+TEST(TankCfgProtocol, VolumeLinesAreOptIn) {
+  FakeSettings s;
+  TankSettings tankSettings(&s, std::string("grey"));
+  TankCfgProtocol p(&tankSettings);
+
+  EXPECT_FALSE(p.volumeLines());
+  EXPECT_EQ(replyTo(p, "VOL?"), "VOL:OFF");
+  EXPECT_EQ(replyTo(p, "VOL:ON"), "OK");
+  EXPECT_TRUE(p.volumeLines());
+  EXPECT_EQ(replyTo(p, "VOL?"), "VOL:ON");
+  EXPECT_EQ(replyTo(p, "VOL:1"), "ERR_VOL");
+  EXPECT_TRUE(p.volumeLines());
+
+  p.resetVolumeLines();
+  EXPECT_EQ(replyTo(p, "VOL?"), "VOL:OFF");
+  EXPECT_TRUE(s.int_values.empty());
 }
@@ -0,0 +1,139 @@
+#include "TelemetryProtocol.h"
+#include "../FakeSettings.h"
+#include "../ReplyTo.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(TelemetryProtocol, ReadReturnsDefaults) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "TLM?"), "TLM:DB=1;HB=10");
+}
+
+TEST(TelemetryProtocol, WritePersistsBothThresholdsInOneCommit) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "TLM:DB=5;HB=30"), "OK");
+
+  EXPECT_EQ(s.int_values["grey_tank_db"], 5);
+  EXPECT_EQ(s.int_values["grey_tank_hb"], 30);
+  EXPECT_EQ(s.commits, 1);
+  EXPECT_EQ(replyTo(p, "TLM?"), "TLM:DB=5;HB=30");
+}
+
+TEST(TelemetryProtocol, WriteAppliesThresholdsToGate) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+  p.begin();
+  const int first[] = {500};
+  const int moved[] = {504};
+  gate.shouldPublish(first, 1, 0);
+  ASSERT_TRUE(gate.shouldPublish(moved, 1, 110));
+
+  replyTo(p, "TLM:DB=5;HB=30");
+
+  EXPECT_FALSE(gate.shouldPublish(first, 1, 220));
+  EXPECT_TRUE(gate.shouldPublish(first, 1, 30110));
+}
+
+TEST(TelemetryProtocol, BeginLoadsPersistedThresholds) {
+  FakeSettings s;
+  s.int_values["environment_db"] = 10;
+  s.int_values["environment_hb"] = 60;
+  TelemetrySettings settings(&s, "environment");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  p.begin();
+
+  const int first[] = {215};
+  const int inside[] = {225};
+  gate.shouldPublish(first, 1, 0);
+  EXPECT_FALSE(gate.shouldPublish(inside, 1, 59999));
+}
+
+TEST(TelemetryProtocol, WriteRejectsMissingField) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "TLM:DB=5"), "ERR_TLM_FMT");
+  EXPECT_TRUE(s.int_values.empty());
+}
+
+TEST(TelemetryProtocol, WriteRejectsNonNumeric) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "TLM:DB=-1;HB=30"), "ERR_TLM_NUM");
+  EXPECT_EQ(replyTo(p, "TLM:DB=5;HB=abc"), "ERR_TLM_NUM");
+  EXPECT_EQ(replyTo(p, "TLM:DB=99999999999;HB=30"), "ERR_TLM_NUM");
+}
+
+TEST(TelemetryProtocol, WriteRejectsOutOfRange) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "TLM:DB=10001;HB=30"), "ERR_TLM_RANGE");
+  EXPECT_EQ(replyTo(p, "TLM:DB=5;HB=0"), "ERR_TLM_RANGE");
+  EXPECT_EQ(replyTo(p, "TLM:DB=5;HB=3601"), "ERR_TLM_RANGE");
+  EXPECT_EQ(replyTo(p, "TLM:DB=0;HB=1"), "OK");
+}
+
+TEST(TelemetryProtocol, IgnoresOtherCommands) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "CFG?"), "");
+  EXPECT_EQ(replyTo(p, "ENV?"), "");
+}
+
+TEST(TelemetryProtocol, AdvertisesBothFormatsAndStartsWithText) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "CAP?"), "CAP:FMT=TXT,BIN");
+  EXPECT_EQ(replyTo(p, "FMT?"), "FMT:TXT");
+  EXPECT_EQ(p.getFormat(), TelemetryProtocol::TEXT);
+}
+
+TEST(TelemetryProtocol, FormatSelectionSwitchesUntilReset) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "FMT:BIN"), "OK");
+  EXPECT_EQ(replyTo(p, "FMT?"), "FMT:BIN");
+  EXPECT_EQ(p.getFormat(), TelemetryProtocol::BINARY);
+
+  p.resetFormat();
+  EXPECT_EQ(p.getFormat(), TelemetryProtocol::TEXT);
+}
+
+TEST(TelemetryProtocol, FormatSelectionRejectsUnknownFormat) {
+  FakeSettings s;
+  TelemetrySettings settings(&s, "grey_tank");
+  TelemetryGate gate(1);
+  TelemetryProtocol p(&settings, &gate);
+
+  EXPECT_EQ(replyTo(p, "FMT:CBOR"), "ERR_FMT");
+  EXPECT_EQ(p.getFormat(), TelemetryProtocol::TEXT);
+}
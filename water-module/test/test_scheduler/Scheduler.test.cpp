@@ -0,0 +1,179 @@
+#include "Scheduler.h"
+#include "../ArduinoMacroGuard.h"
+#include "../MockStream.h"
+#include <climits>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+// Simulated time: only moves when the test (or a task doing "work") advances it
+class FakeClock : public Clock {
+public:
+  unsigned long ms = 0;
+  unsigned long now() override { return ms; }
+};
+
+// Task recording its runs, optionally taking workMs of simulated time
+struct Probe {
+  FakeClock *clock;
+  const char *name;
+  std::vector<std::string> *trace;
+  unsigned long workMs = 0;
+  std::vector<unsigned long> startedAt;
+
+  void run() {
+    startedAt.push_back(clock->ms);
+    if (trace != nullptr) {
+      trace->push_back(name);
+    }
+    clock->ms += workMs;
+  }
+};
+} // namespace
+
+class SchedulerTest : public ::testing::Test {
+protected:
+  MockStream stream;
+  Logger logger{stream, Logger::INFO};
+  FakeClock clock;
+  Scheduler scheduler{clock, &logger};
+
+  // Runs the loop as the firmware does: tick, then sleep until the next release
+  void runFor(unsigned long durationMs) {
+    const unsigned long end = clock.ms + durationMs;
+    while (clock.ms < end) {
+      scheduler.tick();
+      const unsigned long idle = scheduler.idleMs();
+      clock.ms += idle > 0 ? idle : 1;
+    }
+  }
+
+  std::string log() {
+    logger.flush();
+    return std::string(stream.output.begin(), stream.output.end());
+  }
+};
+
+TEST_F(SchedulerTest, EachTaskRunsAtItsOwnRate) {
+  Probe fast{&clock, "fast", nullptr};
+  Probe medium{&clock, "medium", nullptr};
+  Probe slow{&clock, "slow", nullptr};
+  scheduler.every<Probe, &Probe::run>("fast", 100, &fast);
+  scheduler.every<Probe, &Probe::run>("medium", 1000, &medium);
+  scheduler.every<Probe, &Probe::run>("slow", 10000, &slow);
+
+  runFor(10000);
+
+  EXPECT_EQ(fast.startedAt.size(), 100u);
+  EXPECT_EQ(medium.startedAt.size(), 10u);
+  EXPECT_EQ(slow.startedAt.size(), 1u);
+  EXPECT_EQ(medium.startedAt[3], 3000u);
+  EXPECT_EQ(scheduler.getStats(0).overruns, 0u);
+}
+
+TEST_F(SchedulerTest, FirstRunAtTheNextTickThenOnePeriodApart) {
+  clock.ms = 500;
+  Probe probe{&clock, "probe", nullptr};
+  scheduler.every<Probe, &Probe::run>("probe", 250, &probe);
+
+  runFor(1000);
+
+  EXPECT_EQ(probe.startedAt, (std::vector<unsigned long>{500, 750, 1000, 1250}));
+}
+
+TEST_F(SchedulerTest, DueTasksRunInRegistrationOrder) {
+  std::vector<std::string> trace;
+  Probe first{&clock, "first", &trace};
+  Probe second{&clock, "second", &trace};
+  scheduler.every<Probe, &Probe::run>("first", 1000, &first);
+  scheduler.every<Probe, &Probe::run>("second", 500, &second);
+
+  runFor(1001);
+
+  EXPECT_EQ(trace, (std::vector<std::string>{"first", "second", "second", "first", "second"}));
+}
+
+TEST_F(SchedulerTest, SleepsUntilTheNextRelease) {
+  Probe a{&clock, "a", nullptr};
+  Probe b{&clock, "b", nullptr};
+  scheduler.every<Probe, &Probe::run>("a", 300, &a);
+  scheduler.every<Probe, &Probe::run>("b", 200, &b);
+
+  EXPECT_EQ(scheduler.idleMs(), 0u);
+  scheduler.tick();
+  EXPECT_EQ(scheduler.idleMs(), 200u);
+  clock.ms = 150;
+  EXPECT_EQ(scheduler.idleMs(), 50u);
+  clock.ms = 260;
+  EXPECT_EQ(scheduler.idleMs(), 0u);
+}
+
+TEST_F(SchedulerTest, LateStartWithinThePeriodIsNoOverrun) {
+  Probe probe{&clock, "probe", nullptr};
+  scheduler.every<Probe, &Probe::run>("probe", 100, &probe);
+  scheduler.tick();
+
+  clock.ms = 160;
+  scheduler.tick();
+  clock.ms = 200;
+  scheduler.tick();
+
+  EXPECT_EQ(probe.startedAt, (std::vector<unsigned long>{0, 160, 200}));
+  EXPECT_EQ(scheduler.getStats(0).maxLatenessMs, 60u);
+  EXPECT_EQ(scheduler.getStats(0).overruns, 0u);
+}
+
+TEST_F(SchedulerTest, OverrunIsCountedLoggedAndSkipsMissedReleases) {
+  Probe slow{&clock, "slow", nullptr};
+  slow.workMs = 250;
+  scheduler.every<Probe, &Probe::run>("pid", 100, &slow);
+
+  scheduler.tick();
+
+  const Scheduler::Stats &stats = scheduler.getStats(0);
+  EXPECT_EQ(stats.overruns, 1u);
+  EXPECT_EQ(stats.maxRunMs, 250u);
+  // Releases at 100 and 200 went by during the run, the phase is kept
+  EXPECT_EQ(scheduler.idleMs(), 50u);
+  EXPECT_NE(
+      log().find("[WARN] Task pid overran its 100 ms period: started 0 ms late, ran 250 ms, 2 release(s) skipped"),
+      std::string::npos);
+}
+
+TEST_F(SchedulerTest, EndingExactlyOnTheDeadlineIsNoOverrun) {
+  Probe probe{&clock, "probe", nullptr};
+  probe.workMs = 100;
+  scheduler.every<Probe, &Probe::run>("probe", 100, &probe);
+
+  scheduler.tick();
+
+  EXPECT_EQ(scheduler.getStats(0).overruns, 0u);
+  EXPECT_EQ(scheduler.idleMs(), 0u);
+}
+
+TEST_F(SchedulerTest, KeepsItsRateAcrossTheMillisWrap) {
+  clock.ms = ULONG_MAX - 250;
+  Probe probe{&clock, "probe", nullptr};
+  scheduler.every<Probe, &Probe::run>("probe", 100, &probe);
+
+  for (int i = 0; i < 10; i++) {
+    scheduler.tick();
+    clock.ms += scheduler.idleMs();
+  }
+
+  EXPECT_EQ(probe.startedAt.size(), 10u);
+  EXPECT_EQ(probe.startedAt[3], ULONG_MAX - 250 + 300);
+  EXPECT_EQ(scheduler.getStats(0).overruns, 0u);
+}
+
+TEST_F(SchedulerTest, RefusesTasksPastCapacity) {
+  Probe probe{&clock, "probe", nullptr};
+  for (size_t i = 0; i < Scheduler::MAX_TASKS; i++) {
+    EXPECT_EQ((scheduler.every<Probe, &Probe::run>("probe", 100, &probe)), static_cast<int>(i));
+  }
+
+  EXPECT_EQ((scheduler.every<Probe, &Probe::run>("extra", 100, &probe)), -1);
+  EXPECT_EQ(scheduler.getTaskCount(), Scheduler::MAX_TASKS);
+  EXPECT_NE(log().find("No task left for extra"), std::string::npos);
+}
@@ -53,7 +53,7 @@ TEST(InputSignalTest, ReadReturnsMinusOneWhenFirstReadingIsInvalid) {
 TEST(InputSignalTest, AppliesFilters) {
   MockSensor sensor;
   InputSignal input(&sensor);
-  EmaFilter ema(0.5);
+  EmaFilter ema(1, 2);
   input.addFilter(&ema);
 
   sensor.valueToReturn = 200;
@@ -84,4 +84,78 @@ TEST_F(UltrasonicSensorTest, ReadResyncsAfterATruncatedPacket) {
   EXPECT_EQ(500, sensor->read());
 }
 
+TEST_F(UltrasonicSensorTest, ReadResyncsOnAHeaderInsideATruncatedPacket) {
+  mockStream.addByte(0xFF); // truncated frame whose data looks like a header
+  mockStream.addByte(0x01);
+  mockStream.addPacket(0x01, 0xF4);
+
+  EXPECT_EQ(500, sensor->read());
+  EXPECT_EQ(1u, sensor->getChecksumErrorCount());
+}
+
+TEST_F(UltrasonicSensorTest, ReadSkipsGarbageBetweenPackets) {
+  mockStream.addPacket(0x01, 0x00);
+  for (uint8_t b : {0x12, 0x34, 0x56}) {
+    mockStream.addByte(b);
+  }
+  mockStream.addInvalidChecksumPacket(0x03, 0x00);
+  mockStream.addPacket(0x01, 0xF4);
+
+  EXPECT_EQ(500, sensor->read());
+  EXPECT_EQ(1u, sensor->getFramingErrorCount());
+  EXPECT_EQ(1u, sensor->getChecksumErrorCount());
+}
+
+TEST_F(UltrasonicSensorTest, ReadCompletesAPacketSplitAcrossReads) {
+  mockStream.addByte(0xFF);
+  mockStream.addByte(0x01);
+  EXPECT_EQ(-1, sensor->read());
+
+  mockStream.addByte(0xF4);
+  mockStream.addByte(0xF4); // 0xFF + 0x01 + 0xF4
+  EXPECT_EQ(500, sensor->read());
+  EXPECT_EQ(0u, sensor->getFramingErrorCount());
+}
+
+TEST_F(UltrasonicSensorTest, ReadDrainsALargeBacklogInBulk) {
+  for (int i = 0; i < 1000; i++) {
+    mockStream.addPacket(0x01, static_cast<uint8_t>(i % 200));
+  }
+  mockStream.addPacket(0x02, 0x00);
+
+  EXPECT_EQ(512, sensor->read());
+  EXPECT_EQ(0, mockStream.available());
+  EXPECT_EQ(0u, mockStream.readCalls);
+  // 4004 bytes in chunks of up to 64
+  EXPECT_LE(mockStream.readBytesCalls, 4004u / 60 + 1);
+  EXPECT_EQ(0u, sensor->getChecksumErrorCount());
+  EXPECT_EQ(0u, sensor->getFramingErrorCount());
+}
+
+TEST_F(UltrasonicSensorTest, ReadKeepsSyncOnACorruptedBacklog) {
+  unsigned int seed = 11;
+  int expected = -1;
+  for (int i = 0; i < 300; i++) {
+    seed = seed * 1103515245 + 12345;
+    const uint8_t low = static_cast<uint8_t>(seed >> 16);
+    switch ((seed >> 8) % 10) {
+    case 0:
+      mockStream.addByte(low); // line noise
+      break;
+    case 1:
+      mockStream.addInvalidChecksumPacket(0x01, low == 0x01 ? 0x00 : low); // 0x01 would be valid
+      break;
+    default:
+      mockStream.addPacket(0x01, low);
+      expected = 0x100 + low;
+    }
+  }
+  mockStream.addPacket(0x01, 0x2C);
+  expected = 300;
+
+  EXPECT_EQ(expected, sensor->read());
+  EXPECT_GT(sensor->getChecksumErrorCount(), 0u);
+  EXPECT_GT(sensor->getFramingErrorCount(), 0u);
+}
+
 TEST_F(UltrasonicSensorTest, MaxRangeReturns1000) { EXPECT_EQ(1000, sensor->maxRange()); }
@@ -0,0 +1,237 @@
+#include "CachedSettings.h"
+#include "../FakeSettings.h"
+#include <gtest/gtest.h>
+#include <string>
+
+// Backend counting every call the cache lets through
+class CountingSettings : public FakeSettings {
+public:
+  int gets = 0;
+  int saves = 0;
+  int flushes = 0;
+
+  int get(const char *key, const int defaultValue) override {
+    gets++;
+    return FakeSettings::get(key, defaultValue);
+  }
+  void save(const char *key, int value) override {
+    saves++;
+    FakeSettings::save(key, value);
+  }
+  std::string get(const char *key, const std::string defaultValue) override {
+    gets++;
+    return FakeSettings::get(key, defaultValue);
+  }
+  void save(const char *key, const char *value) override {
+    saves++;
+    FakeSettings::save(key, value);
+  }
+  void flush() override { flushes++; }
+};
+
+TEST(CachedSettings, ReadsEachKeyFromBackendOnce) {
+  CountingSettings backend;
+  backend.int_values["heater_kp"] = 1500;
+  CachedSettings settings(&backend);
+
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(settings.get("heater_kp", 1000), 1500);
+  }
+
+  EXPECT_EQ(backend.gets, 1);
+}
+
+TEST(CachedSettings, CachesDefaultOfMissingKey) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  EXPECT_EQ(settings.get("heater_ki", 10), 10);
+  EXPECT_EQ(settings.get("heater_ki", 10), 10);
+  EXPECT_EQ(settings.get("device_name", std::string("Van")), "Van");
+  EXPECT_EQ(settings.get("device_name", std::string("Van")), "Van");
+
+  EXPECT_EQ(backend.gets, 2);
+}
+
+TEST(CachedSettings, SaveIsVisibleBeforeFlushButNotWritten) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.save("grey_v_l", 120);
+  settings.save("device_name", "Van");
+
+  EXPECT_EQ(settings.get("grey_v_l", 150), 120);
+  EXPECT_EQ(settings.get("device_name", std::string("")), "Van");
+  EXPECT_EQ(backend.saves, 0);
+  EXPECT_EQ(backend.gets, 0);
+  EXPECT_EQ(backend.int_values.count("grey_v_l"), 0u);
+}
+
+TEST(CachedSettings, FlushWritesDirtyKeysInOneCommit) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.save("heater_0_kp", 2000);
+  settings.save("heater_0_ki", 50);
+  settings.save("heater_0_kd", 100);
+  settings.save("device_name", "Van");
+  settings.flush();
+
+  EXPECT_EQ(backend.saves, 4);
+  EXPECT_EQ(backend.flushes, 1);
+  EXPECT_EQ(backend.int_values["heater_0_kp"], 2000);
+  EXPECT_EQ(backend.int_values["heater_0_ki"], 50);
+  EXPECT_EQ(backend.int_values["heater_0_kd"], 100);
+  EXPECT_EQ(backend.str_values["device_name"], "Van");
+}
+
+TEST(CachedSettings, RepeatedSavesOfAKeyAreWrittenOnce) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.save("heater_0_sp", 200);
+  settings.save("heater_0_sp", 210);
+  settings.save("heater_0_sp", 220);
+  settings.flush();
+
+  EXPECT_EQ(backend.saves, 1);
+  EXPECT_EQ(backend.int_values["heater_0_sp"], 220);
+}
+
+TEST(CachedSettings, FlushWithoutChangesDoesNotTouchBackend) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.get("heater_kp", 1000);
+  settings.flush();
+  settings.flush();
+
+  EXPECT_EQ(backend.saves, 0);
+  EXPECT_EQ(backend.flushes, 0);
+}
+
+TEST(CachedSettings, SavingTheCurrentValueWritesNothing) {
+  CountingSettings backend;
+  backend.int_values["heater_0_run"] = 1;
+  backend.str_values["device_name"] = "Van";
+  CachedSettings settings(&backend);
+
+  settings.get("heater_0_run", 0);
+  settings.get("device_name", std::string(""));
+  settings.save("heater_0_run", 1);
+  settings.save("device_name", "Van");
+  settings.flush();
+
+  EXPECT_EQ(backend.saves, 0);
+  EXPECT_EQ(backend.flushes, 0);
+}
+
+TEST(CachedSettings, FlushedKeysAreNotWrittenAgain) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.save("grey_valve_ac_s", 45);
+  settings.flush();
+  settings.save("grey_v_l", 90);
+  settings.flush();
+
+  EXPECT_EQ(backend.saves, 2);
+  EXPECT_EQ(backend.flushes, 2);
+}
+
+TEST(CachedSettings, FlushIsDeferredWhileATransactionIsOpen) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.beginTransaction();
+  settings.save("heater_0_kp", 2000);
+  settings.flush();
+
+  EXPECT_EQ(backend.saves, 0);
+  EXPECT_EQ(backend.flushes, 0);
+}
+
+TEST(CachedSettings, CommitWritesTheTransactionInOneBackendCommit) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.beginTransaction();
+  settings.save("heater_0_kp", 2000);
+  settings.save("heater_0_ki", 50);
+  settings.save("heater_0_kd", 100);
+  settings.commit();
+
+  EXPECT_EQ(backend.saves, 3);
+  EXPECT_EQ(backend.flushes, 1);
+  EXPECT_EQ(backend.int_values["heater_0_kd"], 100);
+}
+
+TEST(CachedSettings, NestedTransactionsCommitWithTheOutermostOne) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.beginTransaction();
+  settings.beginTransaction();
+  settings.save("device_name", "Van");
+  settings.commit();
+  EXPECT_EQ(backend.flushes, 0);
+
+  settings.beginTransaction();
+  settings.save("pin_code", 654321);
+  settings.commit();
+  EXPECT_EQ(backend.flushes, 0);
+
+  settings.commit();
+  EXPECT_EQ(backend.saves, 2);
+  EXPECT_EQ(backend.flushes, 1);
+}
+
+TEST(CachedSettings, CommitWithoutTransactionPersistsImmediately) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+
+  settings.save("grey_valve_ac_s", 45);
+  settings.commit();
+
+  EXPECT_EQ(backend.saves, 1);
+  EXPECT_EQ(backend.flushes, 1);
+}
+
+TEST(CachedSettings, KeysPastTheTableGoThroughToTheBackend) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+  char key[] = "key_00";
+  for (size_t i = 0; i < CachedSettings::MAX_INTS; i++) {
+    key[4] = static_cast<char>('0' + i / 10);
+    key[5] = static_cast<char>('0' + i % 10);
+    settings.get(key, 0);
+  }
+  backend.gets = 0;
+
+  settings.save("extra_key", 7);
+  EXPECT_EQ(backend.saves, 1);
+  EXPECT_EQ(settings.get("extra_key", 0), 7);
+  EXPECT_EQ(settings.get("extra_key", 0), 7);
+  EXPECT_EQ(backend.gets, 2);
+
+  // Still committed by flush()
+  settings.flush();
+  EXPECT_EQ(backend.flushes, 1);
+}
+
+TEST(CachedSettings, StringsTooLongToCacheGoThrough) {
+  CountingSettings backend;
+  CachedSettings settings(&backend);
+  const std::string longTable(CachedSettings::MAX_STRING_LENGTH + 1, 'a');
+
+  settings.save("grey_tbl", "0000000a");
+  settings.save("grey_tbl", longTable.c_str());
+  EXPECT_EQ(backend.saves, 1);
+  EXPECT_EQ(settings.get("grey_tbl", std::string()), longTable);
+
+  // Short again: cached, written by the next flush
+  settings.save("grey_tbl", "0000000b");
+  settings.flush();
+  EXPECT_EQ(backend.str_values["grey_tbl"], "0000000b");
+  EXPECT_EQ(settings.get("grey_tbl", std::string()), "0000000b");
+}
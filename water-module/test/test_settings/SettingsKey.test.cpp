@@ -0,0 +1,48 @@
+#include "SettingsKey.h"
+#include "../CountingAllocator.h"
+#include "../FakeSettings.h"
+#include "CachedSettings.h"
+#include "TankSettings.h"
+#include "ValveSettings.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(SettingsKey, JoinsNameAndSuffix) {
+  SettingsKey key("grey_tank", "_h_mm");
+
+  EXPECT_STREQ(key.c_str(), "grey_tank_h_mm");
+}
+
+TEST(SettingsKey, TruncatesToNvsLimit) {
+  SettingsKey key("a_very_long_tank", "_v_l");
+
+  EXPECT_STREQ(key.c_str(), "a_very_long_tan");
+}
+
+TEST(SettingsKey, FitsChecksNvsLimitAtCompileTime) {
+  static_assert(SettingsKey::fits("clean_tank", "_h_mm"), "15 characters fit");
+  static_assert(!SettingsKey::fits("clean_tanks", "_h_mm"), "16 characters do not");
+  static_assert(TankSettings::fitsName("clean_tank"), "longest suffix is _h_mm");
+  static_assert(!ValveSettings::fitsName("grey_valve_1"), "grey_valve_1_ac_s is 17 characters");
+}
+
+TEST(SettingsKey, CachedLookupsDoNotAllocate) {
+  FakeSettings backend;
+  CachedSettings settings(&backend);
+  TankSettings tank(&settings, "clean_tank");
+  ValveSettings valve(&settings, "grey_valve");
+  // First reads fill the cache
+  tank.getVolumeLiters();
+  tank.getHeightMm();
+  valve.getAutoCloseSeconds();
+
+  const int before = CountingAllocator::allocations();
+  int sum = 0;
+  for (int i = 0; i < 100; i++) {
+    sum += tank.getVolumeLiters() + tank.getHeightMm() + valve.getAutoCloseSeconds();
+  }
+  const int allocations = CountingAllocator::allocations() - before;
+
+  EXPECT_EQ(allocations, 0);
+  EXPECT_EQ(sum, 100 * (150 + 500 + 30));
+}
@@ -0,0 +1,132 @@
+#include "TankGeometry.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+// Lying cylinder-ish profile: narrow at the bottom and top, wide in the middle
+const TankGeometry::Point PROFILE[] = {{0, 0}, {100, 10}, {300, 80}, {500, 150}, {600, 160}};
+const int PROFILE_COUNT = sizeof(PROFILE) / sizeof(PROFILE[0]);
+
+// Linear scan reference for the binary search
+int scanDeciLiters(const TankGeometry::Point *points, int count, int levelMm) {
+  if (levelMm <= points[0].heightMm) {
+    return points[0].liters * 10;
+  }
+  for (int i = 1; i < count; i++) {
+    if (levelMm < points[i].heightMm) {
+      const TankGeometry::Point &from = points[i - 1];
+      const TankGeometry::Point &to = points[i];
+      const int rise = (to.liters - from.liters) * 10 * (levelMm - from.heightMm);
+      return from.liters * 10 + rise / (to.heightMm - from.heightMm);
+    }
+  }
+  return points[count - 1].liters * 10;
+}
+} // namespace
+
+TEST(TankGeometry, BoxIsLinearFromEmptyToFull) {
+  TankGeometry geometry;
+  geometry.setBox(150, 500);
+
+  EXPECT_FALSE(geometry.hasTable());
+  EXPECT_EQ(geometry.deciLiters(0), 0);
+  EXPECT_EQ(geometry.deciLiters(250), 750);
+  EXPECT_EQ(geometry.deciLiters(500), 1500);
+}
+
+TEST(TankGeometry, LevelIsHeightMinusDistanceClampedToTheTank) {
+  TankGeometry geometry;
+  geometry.setBox(150, 500);
+
+  EXPECT_EQ(geometry.levelMm(120), 380);
+  EXPECT_EQ(geometry.levelMm(700), 0);
+  EXPECT_EQ(geometry.levelMm(-10), 500);
+}
+
+TEST(TankGeometry, TableInterpolatesBetweenPoints) {
+  TankGeometry geometry;
+  geometry.setBox(150, 600);
+  ASSERT_TRUE(geometry.setTable(PROFILE, PROFILE_COUNT));
+
+  EXPECT_EQ(geometry.deciLiters(100), 100);
+  EXPECT_EQ(geometry.deciLiters(200), 450);
+  EXPECT_EQ(geometry.deciLiters(550), 1550);
+  EXPECT_EQ(geometry.deciLiters(600), 1600);
+  EXPECT_EQ(geometry.deciLiters(900), 1600);
+}
+
+TEST(TankGeometry, BinarySearchMatchesLinearScan) {
+  TankGeometry geometry;
+  geometry.setBox(150, 600);
+  ASSERT_TRUE(geometry.setTable(PROFILE, PROFILE_COUNT));
+
+  for (int level = 0; level <= 650; level++) {
+    ASSERT_EQ(geometry.deciLiters(level), scanDeciLiters(PROFILE, PROFILE_COUNT, level)) << "level " << level;
+  }
+}
+
+TEST(TankGeometry, RateUsesTheSlopeAtTheLevel) {
+  TankGeometry geometry;
+  geometry.setBox(150, 600);
+  ASSERT_TRUE(geometry.setTable(PROFILE, PROFILE_COUNT));
+
+  // 100 mm/min (1000 tenths): 0.1 L/mm at the bottom, 0.35 L/mm in the middle
+  EXPECT_EQ(geometry.deciLitersPerMinute(50, 1000), 100);
+  EXPECT_EQ(geometry.deciLitersPerMinute(400, -1000), -350);
+  EXPECT_EQ(geometry.deciLitersPerMinute(600, 1000), 100);
+}
+
+TEST(TankGeometry, RejectsInvalidTablesWithoutChange) {
+  TankGeometry geometry;
+  geometry.setBox(150, 500);
+  const TankGeometry::Point single[] = {{0, 0}};
+  const TankGeometry::Point flatHeight[] = {{0, 0}, {100, 10}, {100, 20}};
+  const TankGeometry::Point shrinking[] = {{0, 0}, {100, 20}, {200, 10}};
+
+  EXPECT_FALSE(geometry.setTable(single, 1));
+  EXPECT_FALSE(geometry.setTable(flatHeight, 3));
+  EXPECT_FALSE(geometry.setTable(shrinking, 3));
+  EXPECT_FALSE(geometry.hasTable());
+  EXPECT_EQ(geometry.deciLiters(250), 750);
+}
+
+TEST(TankGeometry, ClearingTheTableRestoresTheBox) {
+  TankGeometry geometry;
+  geometry.setBox(150, 600);
+  ASSERT_TRUE(geometry.setTable(PROFILE, PROFILE_COUNT));
+
+  ASSERT_TRUE(geometry.setTable(nullptr, 0));
+  EXPECT_FALSE(geometry.hasTable());
+  EXPECT_EQ(geometry.deciLiters(300), 750);
+}
+
+TEST(TankGeometry, EncodeDecodeRoundTrips) {
+  TankGeometry geometry;
+  ASSERT_TRUE(geometry.setTable(PROFILE, PROFILE_COUNT));
+
+  const std::string encoded = geometry.encode();
+  EXPECT_EQ(encoded.length(), PROFILE_COUNT * TankGeometry::ENCODED_POINT_SIZE);
+  EXPECT_EQ(encoded.substr(0, 16), "000000000064000a");
+
+  TankGeometry::Point points[TankGeometry::MAX_POINTS];
+  int count = 0;
+  ASSERT_TRUE(TankGeometry::decode(encoded, points, count));
+  ASSERT_EQ(count, PROFILE_COUNT);
+  for (int i = 0; i < count; i++) {
+    EXPECT_EQ(points[i].heightMm, PROFILE[i].heightMm);
+    EXPECT_EQ(points[i].liters, PROFILE[i].liters);
+  }
+}
+
+TEST(TankGeometry, DecodeRejectsMalformedInput) {
+  TankGeometry::Point points[TankGeometry::MAX_POINTS];
+  int count = 7;
+
+  EXPECT_FALSE(TankGeometry::decode("0000000", points, count));
+  EXPECT_FALSE(TankGeometry::decode("000000000064zz0a", points, count));
+  EXPECT_FALSE(TankGeometry::decode("0064000a00000000", points, count));
+  EXPECT_EQ(count, 7);
+
+  ASSERT_TRUE(TankGeometry::decode("", points, count));
+  EXPECT_EQ(count, 0);
+}
@@ -13,3 +13,33 @@ TEST(TankSettings, FromNameUsesExpectedPrefixWithSettingsCalls) {
   EXPECT_EQ(settings.int_values["any_name_v_l"], 111);
   EXPECT_EQ(settings.int_values["any_name_h_mm"], 222);
 }
+
+TEST(TankSettings, LoadGeometryUsesStoredTable) {
+  FakeSettings settings;
+  settings.int_values["grey_v_l"] = 100;
+  settings.int_values["grey_h_mm"] = 400;
+  settings.str_values["grey_tbl"] = "00000000012c001e0190003c";
+  TankSettings tank(&settings, "grey");
+  TankGeometry geometry;
+
+  tank.loadGeometry(geometry);
+
+  EXPECT_TRUE(geometry.hasTable());
+  EXPECT_EQ(geometry.levelMm(100), 300);
+  EXPECT_EQ(geometry.deciLiters(300), 300);
+  EXPECT_EQ(geometry.deciLiters(350), 450);
+}
+
+TEST(TankSettings, LoadGeometryFallsBackToBoxOnCorruptTable) {
+  FakeSettings settings;
+  settings.int_values["grey_v_l"] = 100;
+  settings.int_values["grey_h_mm"] = 400;
+  settings.str_values["grey_tbl"] = "garbage";
+  TankSettings tank(&settings, "grey");
+  TankGeometry geometry;
+
+  tank.loadGeometry(geometry);
+
+  EXPECT_FALSE(geometry.hasTable());
+  EXPECT_EQ(geometry.deciLiters(200), 500);
+}
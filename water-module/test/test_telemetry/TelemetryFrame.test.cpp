@@ -0,0 +1,150 @@
+#include "TelemetryFrame.h"
+#include <gtest/gtest.h>
+
+TEST(TelemetryFrame, Crc16MatchesCcittFalseCheckValue) {
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+  EXPECT_EQ(TelemetryFrame::crc16(check, sizeof(check)), 0x29B1);
+}
+
+TEST(TelemetryFrame, EncodesEnvironmentLittleEndian) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::Environment environment = {225, 450, 10132, -12};
+
+  const size_t length = TelemetryFrame::encode(environment, 7, frame);
+
+  ASSERT_EQ(length, TelemetryFrame::ENVIRONMENT_SIZE);
+  EXPECT_EQ(frame[0], TelemetryFrame::ENVIRONMENT);
+  EXPECT_EQ(frame[1], 7);
+  EXPECT_EQ(frame[2], 0xE1); // 225
+  EXPECT_EQ(frame[3], 0x00);
+  EXPECT_EQ(frame[6], 0x94); // 10132 = 0x2794
+  EXPECT_EQ(frame[7], 0x27);
+  EXPECT_EQ(frame[8], 0xF4); // -12 = 0xFFF4
+  EXPECT_EQ(frame[9], 0xFF);
+  const uint16_t crc = TelemetryFrame::crc16(frame, length - 2);
+  EXPECT_EQ(frame[10], crc & 0xFF);
+  EXPECT_EQ(frame[11], crc >> 8);
+}
+
+TEST(TelemetryFrame, PerChannelFramesFitOneTwentyByteNotification) {
+  EXPECT_EQ(TelemetryFrame::HEATER_STATUS_SIZE, 9u);
+  EXPECT_EQ(TelemetryFrame::ENVIRONMENT_SIZE, 12u);
+  EXPECT_EQ(TelemetryFrame::TANK_LEVEL_SIZE, 6u);
+  EXPECT_EQ(TelemetryFrame::TANK_VOLUME_SIZE, 8u);
+  EXPECT_EQ(TelemetryFrame::HEATER_SNAPSHOT_SIZE, 36u);
+  EXPECT_EQ(TelemetryFrame::MAX_SIZE, TelemetryFrame::HEATER_SNAPSHOT_SIZE);
+}
+
+TEST(TelemetryFrame, HeaterStatusRoundTrips) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::HeaterStatus sent = {-35, 200, true};
+  const size_t length = TelemetryFrame::encode(sent, 255, frame);
+
+  TelemetryFrame::HeaterStatus received = {};
+  uint8_t sequence = 0;
+  ASSERT_TRUE(TelemetryFrame::decode(frame, length, received, sequence));
+
+  EXPECT_EQ(received.temperature, -35);
+  EXPECT_EQ(received.setpoint, 200);
+  EXPECT_TRUE(received.running);
+  EXPECT_EQ(sequence, 255);
+}
+
+TEST(TelemetryFrame, EnvironmentRoundTrips) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::Environment sent = {225, 450, 10132, -120};
+  const size_t length = TelemetryFrame::encode(sent, 1, frame);
+
+  TelemetryFrame::Environment received = {};
+  uint8_t sequence = 0;
+  ASSERT_TRUE(TelemetryFrame::decode(frame, length, received, sequence));
+
+  EXPECT_EQ(received.temperature, 225);
+  EXPECT_EQ(received.humidity, 450);
+  EXPECT_EQ(received.pressure, 10132);
+  EXPECT_EQ(received.exterior, -120);
+  EXPECT_EQ(sequence, 1);
+}
+
+TEST(TelemetryFrame, TankLevelRoundTrips) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::TankLevel sent = {482};
+  const size_t length = TelemetryFrame::encode(sent, 42, frame);
+
+  TelemetryFrame::TankLevel received = {};
+  uint8_t sequence = 0;
+  ASSERT_TRUE(TelemetryFrame::decode(frame, length, received, sequence));
+
+  EXPECT_EQ(received.distanceMm, 482);
+  EXPECT_EQ(sequence, 42);
+}
+
+TEST(TelemetryFrame, TankVolumeRoundTrips) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::TankVolume sent = {1275, -153};
+  const size_t length = TelemetryFrame::encode(sent, 9, frame);
+
+  TelemetryFrame::TankVolume received = {0, 0};
+  uint8_t sequence = 0;
+  ASSERT_EQ(length, TelemetryFrame::TANK_VOLUME_SIZE);
+  EXPECT_EQ(frame[0], TelemetryFrame::TANK_VOLUME);
+  ASSERT_TRUE(TelemetryFrame::decode(frame, length, received, sequence));
+  EXPECT_EQ(received.deciLiters, 1275);
+  EXPECT_EQ(received.deciLitersPerMinute, -153);
+  EXPECT_EQ(sequence, 9);
+}
+
+TEST(TelemetryFrame, HeaterSnapshotRoundTrips) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::HeaterSnapshot sent = {
+      {{215, 200, true, 128}, {190, 200, false, 0}, {-40, 50, true, 255}, {0, 0, false, 0}}, {225, 450, 10132, -12}};
+  const size_t length = TelemetryFrame::encode(sent, 3, frame);
+
+  TelemetryFrame::HeaterSnapshot received = {};
+  uint8_t sequence = 0;
+  ASSERT_EQ(length, TelemetryFrame::HEATER_SNAPSHOT_SIZE);
+  ASSERT_TRUE(TelemetryFrame::decode(frame, length, received, sequence));
+  EXPECT_EQ(sequence, 3);
+  for (size_t i = 0; i < TelemetryFrame::SNAPSHOT_ZONES; i++) {
+    EXPECT_EQ(received.zones[i].temperature, sent.zones[i].temperature);
+    EXPECT_EQ(received.zones[i].setpoint, sent.zones[i].setpoint);
+    EXPECT_EQ(received.zones[i].running, sent.zones[i].running);
+    EXPECT_EQ(received.zones[i].fanOutput, sent.zones[i].fanOutput);
+  }
+  EXPECT_EQ(received.environment.temperature, 225);
+  EXPECT_EQ(received.environment.humidity, 450);
+  EXPECT_EQ(received.environment.pressure, 10132);
+  EXPECT_EQ(received.environment.exterior, -12);
+}
+
+TEST(TelemetryFrame, DecodeRejectsCorruptedFrame) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::TankLevel sent = {482};
+  const size_t length = TelemetryFrame::encode(sent, 42, frame);
+  frame[2] ^= 0x01;
+
+  TelemetryFrame::TankLevel received = {};
+  uint8_t sequence = 0;
+  EXPECT_FALSE(TelemetryFrame::decode(frame, length, received, sequence));
+}
+
+TEST(TelemetryFrame, DecodeRejectsWrongTypeOrLength) {
+  uint8_t frame[TelemetryFrame::MAX_SIZE];
+  const TelemetryFrame::TankLevel sent = {482};
+  const size_t length = TelemetryFrame::encode(sent, 42, frame);
+
+  TelemetryFrame::HeaterStatus status = {};
+  TelemetryFrame::TankLevel level = {};
+  uint8_t sequence = 0;
+  EXPECT_FALSE(TelemetryFrame::decode(frame, length, status, sequence));
+  EXPECT_FALSE(TelemetryFrame::decode(frame, length - 1, level, sequence));
+}
+
+TEST(TelemetryFrame, ConversionsSaturate) {
+  EXPECT_EQ(TelemetryFrame::toInt16(40000), INT16_MAX);
+  EXPECT_EQ(TelemetryFrame::toInt16(-40000), INT16_MIN);
+  EXPECT_EQ(TelemetryFrame::toInt16(-35), -35);
+  EXPECT_EQ(TelemetryFrame::toUint16(70000), UINT16_MAX);
+  EXPECT_EQ(TelemetryFrame::toUint16(-1), 0);
+}
@@ -0,0 +1,94 @@
+#include "TelemetryGate.h"
+#include <gtest/gtest.h>
+
+TEST(TelemetryGate, PublishesFirstFrame) {
+  TelemetryGate gate(1);
+  gate.configure(2, 10000);
+  const int values[] = {215};
+
+  EXPECT_TRUE(gate.shouldPublish(values, 1, 0));
+}
+
+TEST(TelemetryGate, SuppressesMeasurementWithinDeadband) {
+  TelemetryGate gate(1);
+  gate.configure(2, 10000);
+  const int first[] = {215};
+  const int inside[] = {217};
+  const int outside[] = {218};
+
+  gate.shouldPublish(first, 1, 0);
+
+  EXPECT_FALSE(gate.shouldPublish(inside, 1, 110));
+  EXPECT_TRUE(gate.shouldPublish(outside, 1, 220));
+}
+
+TEST(TelemetryGate, ComparesWithLastPublishedFrameSoDriftAddsUp) {
+  TelemetryGate gate(1);
+  gate.configure(2, 10000);
+  const int start[] = {200};
+  const int step1[] = {202};
+  const int step2[] = {203};
+
+  gate.shouldPublish(start, 1, 0);
+
+  EXPECT_FALSE(gate.shouldPublish(step1, 1, 110));
+  EXPECT_TRUE(gate.shouldPublish(step2, 1, 220));
+}
+
+TEST(TelemetryGate, PublishesAnyStateChange) {
+  TelemetryGate gate(1);
+  gate.configure(5, 10000);
+  const int stopped[] = {215, 200, 0};
+  const int running[] = {215, 200, 1};
+
+  gate.shouldPublish(stopped, 3, 0);
+
+  EXPECT_FALSE(gate.shouldPublish(stopped, 3, 110));
+  EXPECT_TRUE(gate.shouldPublish(running, 3, 220));
+}
+
+TEST(TelemetryGate, PublishesOnHeartbeat) {
+  TelemetryGate gate(1);
+  gate.configure(2, 10000);
+  const int values[] = {215};
+
+  gate.shouldPublish(values, 1, 1000);
+
+  EXPECT_FALSE(gate.shouldPublish(values, 1, 10999));
+  EXPECT_TRUE(gate.shouldPublish(values, 1, 11000));
+  EXPECT_FALSE(gate.shouldPublish(values, 1, 11110));
+}
+
+TEST(TelemetryGate, ZeroDeadbandPublishesEveryChange) {
+  TelemetryGate gate(1);
+  gate.configure(0, 10000);
+  const int first[] = {215};
+  const int next[] = {216};
+
+  gate.shouldPublish(first, 1, 0);
+
+  EXPECT_FALSE(gate.shouldPublish(first, 1, 110));
+  EXPECT_TRUE(gate.shouldPublish(next, 1, 220));
+}
+
+TEST(TelemetryGate, InvalidatePublishesNextFrame) {
+  TelemetryGate gate(1);
+  gate.configure(2, 10000);
+  const int values[] = {215};
+  gate.shouldPublish(values, 1, 0);
+
+  gate.invalidate();
+
+  EXPECT_TRUE(gate.shouldPublish(values, 1, 110));
+}
+
+TEST(TelemetryGate, HandlesMillisRollover) {
+  TelemetryGate gate(1);
+  gate.configure(2, 10000);
+  const int values[] = {215};
+
+  gate.shouldPublish(values, 1, ~0UL - 0xFF);
+
+  EXPECT_FALSE(gate.shouldPublish(values, 1, 0x100UL));
+  EXPECT_TRUE(gate.shouldPublish(values, 1, 0x2800UL));
+}
@@ -0,0 +1,271 @@
+#include "ChunkedSender.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Sender recording every chunk, refusing them while the stack is "congested"
+class RecordingSender : public ChunkedSender {
+public:
+  std::vector<std::string> chunks;
+  bool congested = false;
+
+protected:
+  bool transmit(const uint8_t *data, size_t length) override {
+    if (congested) {
+      return false;
+    }
+    chunks.push_back(std::string(reinterpret_cast<const char *>(data), length));
+    return true;
+  }
+};
+
+TEST(ChunkedSender, SendOnlyQueues) {
+  RecordingSender sender;
+
+  sender.send("LVL:42");
+
+  EXPECT_TRUE(sender.chunks.empty());
+  EXPECT_EQ(sender.getQueueDepth(), 1u);
+}
+
+TEST(ChunkedSender, SplitsInTwentyByteChunksUntilMtuIsNegotiated) {
+  RecordingSender sender;
+
+  sender.send("STATUS:T=215;SP=200;RUN=1;FAN=100");
+  sender.flush();
+
+  ASSERT_EQ(sender.chunks.size(), 2u);
+  EXPECT_EQ(sender.chunks[0], "STATUS:T=215;SP=200;");
+  EXPECT_EQ(sender.chunks[1], "RUN=1;FAN=100\n");
+}
+
+TEST(ChunkedSender, SendsWholeMessageInOneChunkWhenItFitsTheMtu) {
+  RecordingSender sender;
+  sender.setMtu(185);
+
+  sender.send("STATUS:T=215;SP=200;RUN=1;FAN=100");
+  sender.flush();
+
+  ASSERT_EQ(sender.chunks.size(), 1u);
+  EXPECT_EQ(sender.chunks[0], "STATUS:T=215;SP=200;RUN=1;FAN=100\n");
+  EXPECT_EQ(sender.getChunkSize(), 182u);
+}
+
+TEST(ChunkedSender, ClampsChunkSizeToAttLimits) {
+  RecordingSender sender;
+
+  sender.setMtu(10);
+  EXPECT_EQ(sender.getChunkSize(), 20u);
+
+  sender.setMtu(517);
+  EXPECT_EQ(sender.getChunkSize(), ChunkedSender::MAX_CHUNK_SIZE);
+}
+
+TEST(ChunkedSender, PacksQueuedMessagesInSharedChunks) {
+  RecordingSender sender;
+
+  sender.send("LVL:42");
+  sender.send("LVL:43");
+  sender.send("COUNTDOWN:12");
+  sender.flush();
+
+  // The app splits messages on the end-of-message marker, wherever chunks end
+  ASSERT_EQ(sender.chunks.size(), 2u);
+  EXPECT_EQ(sender.chunks[0], "LVL:42\nLVL:43\nCOUNTD");
+  EXPECT_EQ(sender.chunks[1], "OWN:12\n");
+  EXPECT_EQ(sender.getQueueDepth(), 0u);
+}
+
+TEST(ChunkedSender, KeepsRefusedChunksUntilNextFlush) {
+  RecordingSender sender;
+  sender.setMtu(185);
+  sender.congested = true;
+
+  sender.send("LVL:42");
+  sender.flush();
+  sender.send("LVL:43");
+  sender.flush();
+
+  EXPECT_TRUE(sender.chunks.empty());
+  EXPECT_EQ(sender.getQueueDepth(), 2u);
+  EXPECT_EQ(sender.getCongestionCount(), 2u);
+
+  sender.congested = false;
+  sender.flush();
+
+  ASSERT_EQ(sender.chunks.size(), 1u);
+  EXPECT_EQ(sender.chunks[0], "LVL:42\nLVL:43\n");
+}
+
+TEST(ChunkedSender, ResumesAfterTheLastAcceptedChunk) {
+  // Refuses every chunk after the first one
+  class FirstChunkOnlySender : public RecordingSender {
+  protected:
+    bool transmit(const uint8_t *data, size_t length) override {
+      const bool accepted = RecordingSender::transmit(data, length);
+      congested = true;
+      return accepted;
+    }
+  } sender;
+
+  sender.send("0123456789012345678901234");
+  sender.flush();
+  ASSERT_EQ(sender.chunks.size(), 1u);
+
+  sender.congested = false;
+  sender.flush();
+
+  ASSERT_EQ(sender.chunks.size(), 2u);
+  EXPECT_EQ(sender.chunks[1], "01234\n");
+}
+
+TEST(ChunkedSender, NeverEvictsAPartlySentMessage) {
+  class FirstChunkOnlySender : public RecordingSender {
+  protected:
+    bool transmit(const uint8_t *data, size_t length) override {
+      const bool accepted = RecordingSender::transmit(data, length);
+      congested = true;
+      return accepted;
+    }
+  } sender;
+  sender.send("STATUS:T=215;SP=200;RUN=1", OutboundQueue::DROP_OLDEST);
+  sender.flush();
+
+  for (size_t i = 0; i < OutboundQueue::CAPACITY; i++) {
+    sender.send("STATUS:T=216;SP=200;RUN=1", OutboundQueue::DROP_OLDEST);
+  }
+  sender.congested = false;
+  sender.flush();
+
+  // The tail of the first status still follows its head
+  ASSERT_GE(sender.chunks.size(), 2u);
+  EXPECT_EQ(sender.chunks[1].substr(0, 6), "RUN=1\n");
+  EXPECT_EQ(sender.getDropCount(), 1u);
+}
+
+TEST(ChunkedSender, SendsEachBinaryFrameAloneAndUnmarked) {
+  RecordingSender sender;
+  sender.setMtu(185);
+  const uint8_t frame[] = {0x03, 0x01, 0x0A, 0x00, 0x12, 0x34};
+
+  sender.send("OK");
+  sender.sendFrame(frame, sizeof(frame), OutboundQueue::DROP_OLDEST);
+  sender.send("LVL:42");
+  sender.flush();
+
+  ASSERT_EQ(sender.chunks.size(), 3u);
+  EXPECT_EQ(sender.chunks[0], "OK\n");
+  EXPECT_EQ(sender.chunks[1], std::string(reinterpret_cast<const char *>(frame), sizeof(frame)));
+  EXPECT_EQ(sender.chunks[2], "LVL:42\n");
+}
+
+TEST(ChunkedSender, SplitsFrameLongerThanTheChunkWithoutSharing) {
+  RecordingSender sender;
+  uint8_t frame[36];
+  for (size_t i = 0; i < sizeof(frame); i++) {
+    frame[i] = static_cast<uint8_t>(i);
+  }
+
+  EXPECT_TRUE(sender.sendFrame(frame, sizeof(frame), OutboundQueue::DROP_OLDEST));
+  sender.send("OK");
+  sender.flush();
+
+  const std::string bytes(reinterpret_cast<const char *>(frame), sizeof(frame));
+  ASSERT_EQ(sender.chunks.size(), 3u);
+  EXPECT_EQ(sender.chunks[0], bytes.substr(0, 20));
+  EXPECT_EQ(sender.chunks[1], bytes.substr(20));
+  EXPECT_EQ(sender.chunks[2], "OK\n");
+}
+
+TEST(ChunkedSender, ClearDropsQueuedMessages) {
+  RecordingSender sender;
+  sender.send("LVL:42");
+
+  sender.clear();
+  sender.flush();
+
+  EXPECT_TRUE(sender.chunks.empty());
+}
+
+TEST(ChunkedSender, TelemetryCannotTakeTheSlotsKeptForReplies) {
+  RecordingSender sender;
+  sender.setMtu(185);
+
+  size_t staged = 0;
+  while (sender.send("LVL:42", OutboundQueue::DROP_OLDEST)) {
+    staged++;
+  }
+  EXPECT_EQ(staged, ChunkedSender::STAGING_CAPACITY - ChunkedSender::REPLY_RESERVE);
+  for (size_t i = 0; i < ChunkedSender::REPLY_RESERVE; i++) {
+    EXPECT_TRUE(sender.send("OK"));
+  }
+  EXPECT_FALSE(sender.send("OK"));
+  EXPECT_EQ(sender.getDropCount(), 2u);
+
+  sender.flush();
+  std::string received;
+  for (const std::string &chunk : sender.chunks) {
+    received += chunk;
+  }
+  EXPECT_NE(received.find("OK\nOK\nOK\nOK\nOK\nOK\nOK\nOK\n"), std::string::npos);
+  EXPECT_TRUE(sender.send("LVL:42", OutboundQueue::DROP_OLDEST));
+}
+
+TEST(ChunkedSender, RepliesWaitStagedWhileTheQueueIsFullOfReplies) {
+  RecordingSender sender;
+  sender.setMtu(185);
+  for (size_t i = 0; i < ChunkedSender::STAGING_CAPACITY; i++) {
+    EXPECT_TRUE(sender.send("ACK:" + std::to_string(i)));
+  }
+
+  sender.congested = true;
+  sender.flush();
+  sender.congested = false;
+  sender.flush();
+
+  std::string received;
+  for (const std::string &chunk : sender.chunks) {
+    received += chunk;
+  }
+  std::string expected;
+  for (size_t i = 0; i < ChunkedSender::STAGING_CAPACITY; i++) {
+    expected += "ACK:" + std::to_string(i) + "\n";
+  }
+  EXPECT_EQ(received, expected);
+  EXPECT_EQ(sender.getDropCount(), 0u);
+}
+
+// The control task sends while the radio task flushes: every reply arrives, in order
+TEST(ChunkedSender, ProducerAndFlusherOnTwoThreads) {
+  RecordingSender sender;
+  sender.setMtu(185);
+  const int count = 5000;
+  std::atomic<bool> done{false};
+
+  std::thread radio([&]() {
+    while (!done.load()) {
+      sender.flush();
+    }
+    sender.flush();
+  });
+  for (int i = 0; i < count; i++) {
+    const std::string reply = "ACK:" + std::to_string(i);
+    while (!sender.send(reply)) {
+      std::this_thread::yield();
+    }
+  }
+  done = true;
+  radio.join();
+
+  std::string received;
+  for (const std::string &chunk : sender.chunks) {
+    received += chunk;
+  }
+  std::string expected;
+  for (int i = 0; i < count; i++) {
+    expected += "ACK:" + std::to_string(i) + "\n";
+  }
+  EXPECT_EQ(received, expected);
+}
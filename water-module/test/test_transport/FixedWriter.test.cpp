@@ -0,0 +1,88 @@
+#include "FixedWriter.h"
+#include "../CountingAllocator.h"
+#include "ChunkedSender.h"
+#include <climits>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+class NullSender : public ChunkedSender {
+protected:
+  bool transmit(const uint8_t *, size_t) override { return true; }
+};
+} // namespace
+
+TEST(FixedWriter, IntegersMatchToString) {
+  const long long values[] = {0, 7, -7, 10, 99, -100, 123456, INT_MAX, INT_MIN, LLONG_MAX, LLONG_MIN};
+
+  for (long long value : values) {
+    FixedWriter<32> writer;
+    writer.appendInt(value);
+    EXPECT_EQ(writer.view(), std::to_string(value));
+  }
+}
+
+TEST(FixedWriter, FixedDecimals) {
+  FixedWriter<64> writer;
+
+  writer.appendFixed(235, 1).append(' ').appendFixed(-5, 1).append(' ').appendFixed(100205, 3);
+  writer.append(' ').appendFixed(0, 2).append(' ').appendFixed(-42, 0);
+
+  EXPECT_EQ(writer.view(), "23.5 -0.5 100.205 0.00 -42");
+}
+
+TEST(FixedWriter, CutsAtCapacityAndStaysTerminated) {
+  FixedWriter<8> writer;
+
+  writer.append("COUNTDOWN:").appendInt(12);
+
+  EXPECT_TRUE(writer.overflowed());
+  EXPECT_EQ(writer.size(), 8u);
+  EXPECT_STREQ(writer.data(), "COUNTDOW");
+
+  writer.clear();
+  writer.appendInt(-1);
+  EXPECT_FALSE(writer.overflowed());
+  EXPECT_STREQ(writer.data(), "-1");
+}
+
+// Same bytes as the std::string + std::to_string chains the notify paths used to build
+TEST(FixedWriter, MessagesAreByteIdentical) {
+  const int values[] = {0, 215, -40, 9999, INT_MIN, INT_MAX};
+
+  for (int a : values) {
+    for (int b : values) {
+      FixedWriter<128> status;
+      status.append("STATUS:T=").appendInt(a).append(";SP=").appendInt(b).append(";RUN=").append(a > b ? '1' : '0');
+      EXPECT_EQ(status.view(),
+                "STATUS:T=" + std::to_string(a) + ";SP=" + std::to_string(b) + ";RUN=" + (a > b ? "1" : "0"));
+
+      FixedWriter<128> volume;
+      volume.append("VOL:V=").appendInt(a).append(";R=").appendInt(b);
+      EXPECT_EQ(volume.view(), "VOL:V=" + std::to_string(a) + ";R=" + std::to_string(b));
+    }
+  }
+
+  const int zones[] = {215, -12, 0};
+  FixedWriter<128> snapshot;
+  snapshot.append("SNAP:T=").appendInts(zones, 3).append(";ENV=").appendInt(1013);
+  std::string expected = "SNAP:T=";
+  for (size_t i = 0; i < 3; i++) {
+    expected += (i == 0 ? "" : ",") + std::to_string(zones[i]);
+  }
+  EXPECT_EQ(snapshot.view(), expected + ";ENV=1013");
+}
+
+TEST(FixedWriter, FormattingAndQueueingDoNotAllocate) {
+  NullSender sender;
+  const int zones[] = {215, 198, 230};
+
+  const int before = CountingAllocator::allocations();
+  FixedWriter<OutboundQueue::MAX_MESSAGE_SIZE> message;
+  message.append("SNAP:T=").appendInts(zones, 3).append(";ENV=").appendInt(-35).append(',').appendFixed(1013, 1);
+  EXPECT_TRUE(sender.send(message.data(), message.size(), OutboundQueue::DROP_OLDEST));
+  EXPECT_TRUE(sender.send("OK"));
+
+  EXPECT_EQ(CountingAllocator::allocations(), before);
+  EXPECT_EQ(sender.getQueueDepth(), 2u);
+}
@@ -0,0 +1,100 @@
+#include "OutboundQueue.h"
+#include <gtest/gtest.h>
+#include <string>
+
+static bool push(OutboundQueue &queue, const std::string &message, OutboundQueue::Policy policy) {
+  return queue.push(message.data(), message.length(), policy);
+}
+
+static std::string front(const OutboundQueue &queue) { return std::string(queue.data(0), queue.length(0)); }
+
+TEST(OutboundQueue, KeepsMessagesInOrder) {
+  OutboundQueue queue;
+  push(queue, "LVL:42", OutboundQueue::DROP_OLDEST);
+  push(queue, "OK", OutboundQueue::NEVER_DROP);
+
+  ASSERT_EQ(queue.size(), 2u);
+  EXPECT_EQ(front(queue), "LVL:42");
+  queue.pop();
+  EXPECT_EQ(front(queue), "OK");
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(OutboundQueue, FullQueueEvictsOldestTelemetry) {
+  OutboundQueue queue;
+  push(queue, "OK", OutboundQueue::NEVER_DROP);
+  for (size_t i = 1; i < OutboundQueue::CAPACITY; i++) {
+    push(queue, "LVL:" + std::to_string(i), OutboundQueue::DROP_OLDEST);
+  }
+
+  EXPECT_TRUE(push(queue, "LVL:99", OutboundQueue::DROP_OLDEST));
+
+  EXPECT_EQ(queue.size(), OutboundQueue::CAPACITY);
+  EXPECT_EQ(queue.getDropCount(), 1u);
+  EXPECT_EQ(front(queue), "OK");
+  queue.pop();
+  EXPECT_EQ(front(queue), "LVL:2");
+}
+
+TEST(OutboundQueue, ReplyEvictsTelemetryToGetIn) {
+  OutboundQueue queue;
+  for (size_t i = 0; i < OutboundQueue::CAPACITY; i++) {
+    push(queue, "LVL:" + std::to_string(i), OutboundQueue::DROP_OLDEST);
+  }
+
+  EXPECT_TRUE(queue.canPush());
+  EXPECT_TRUE(push(queue, "OK", OutboundQueue::NEVER_DROP));
+
+  EXPECT_EQ(front(queue), "LVL:1");
+  EXPECT_EQ(queue.getDropCount(), 1u);
+}
+
+TEST(OutboundQueue, RefusesMessageWhenOnlyRepliesAreQueued) {
+  OutboundQueue queue;
+  for (size_t i = 0; i < OutboundQueue::CAPACITY; i++) {
+    push(queue, "OK", OutboundQueue::NEVER_DROP);
+  }
+
+  EXPECT_FALSE(queue.canPush());
+  EXPECT_FALSE(push(queue, "ERR_CFG_FMT", OutboundQueue::NEVER_DROP));
+  EXPECT_FALSE(push(queue, "LVL:42", OutboundQueue::DROP_OLDEST));
+
+  EXPECT_EQ(queue.size(), OutboundQueue::CAPACITY);
+  EXPECT_EQ(queue.getDropCount(), 2u);
+}
+
+TEST(OutboundQueue, HeldFrontIsNotEvicted) {
+  OutboundQueue queue;
+  for (size_t i = 0; i < OutboundQueue::CAPACITY; i++) {
+    push(queue, "LVL:" + std::to_string(i), OutboundQueue::DROP_OLDEST);
+  }
+  queue.holdFront(true);
+
+  push(queue, "LVL:99", OutboundQueue::DROP_OLDEST);
+
+  EXPECT_EQ(front(queue), "LVL:0");
+  queue.pop();
+  EXPECT_EQ(front(queue), "LVL:2");
+}
+
+TEST(OutboundQueue, RefusesOversizedMessage) {
+  OutboundQueue queue;
+
+  EXPECT_FALSE(push(queue, std::string(OutboundQueue::MAX_MESSAGE_SIZE + 1, 'x'), OutboundQueue::NEVER_DROP));
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.getDropCount(), 1u);
+}
+
+TEST(OutboundQueue, TracksMaxDepth) {
+  OutboundQueue queue;
+  push(queue, "A", OutboundQueue::NEVER_DROP);
+  push(queue, "B", OutboundQueue::NEVER_DROP);
+  queue.pop();
+  queue.pop();
+  push(queue, "C", OutboundQueue::NEVER_DROP);
+
+  EXPECT_EQ(queue.size(), 1u);
+  EXPECT_EQ(queue.getMaxDepth(), 2u);
+}